@@ -0,0 +1,187 @@
+//////////////////////////////////////////////////
+#ifndef CONCURRENTPOINTERLIST_H
+#define CONCURRENTPOINTERLIST_H
+//////////////////////////////////////////////////
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <algorithm>
+#include <cstddef>
+#include <concepts>
+#include <type_traits>
+//////////////////////////////////////////////////
+/*
+* thread-safe variant of the PointerList (see PointerList.hpp).
+* 
+* elements may be registered, unregistered, moved and destroyed on any thread
+* while other threads iterate the list.
+* 
+* reading works RCU-style: 'ConcurrentPointerList<Type>::read()' hands out an immutable
+* snapshot of the pointer-array. iterating a snapshot takes no lock and always sees a
+* consistent set of pointers, even while writers change the list.
+* 
+* writers serialize on a mutex, update the dense slot-array (O(1) like the PointerList)
+* and publish a fresh snapshot (copy-on-write, O(n) copy of the pointers).
+* 
+* removing an element (unregistering or destroying it) and relocating it (moving it) wait for a
+* grace period: they only return once every snapshot that could still contain the old pointer
+* has been released by its readers. after that it is safe to free the memory of the element.
+* readers should therefore keep snapshots short-lived and never remove elements while holding one.
+* 
+* the object owning an element is still responsible for its own lifetime, i.e. only one thread
+* may construct, move or destroy one specific element at a time. because the base-class destructor
+* runs after the derived parts are gone, derived types that readers call into should call
+* 'removefromPointerList()' in their own destructor first.
+* for the same reason a moved-to element only takes over the slot of the moved-from element
+* once its derived move constructor/assignment calls 'relocateFrom(other)', so readers never
+* see an object that is only partially constructed.
+* 
+* EXAMPLE:
+* 
+* struct Entity : public ConcurrentPointerListElement<Entity> {
+*	Entity() : ConcurrentPointerListElement<Entity>(this) {}
+*	Entity(const Entity&) : ConcurrentPointerListElement<Entity>(this) {}
+*	Entity(Entity&& other) : ConcurrentPointerListElement<Entity>(this) { ...; relocateFrom(other); }
+*	Entity& operator=(Entity&& other) { ...; relocateFrom(other); return *this; }
+*	~Entity() { removefromPointerList(); }
+*	virtual void tick();
+* }
+* 
+* ConcurrentPointerList<Entity> entities;
+* 
+* // worker thread
+* Entity e;
+* entities.addElement(e);
+* 
+* // tick thread
+* for (Entity* ptr : entities.read()) { ptr->tick(); }
+* 
+*/
+//////////////////////////////////////////////////
+template <typename Ty> class ConcurrentPointerListElement;
+template <typename Ty> class ConcurrentPointerList;
+//////////////////////////////////////////////////
+template <typename Ty>
+concept ConcurrentPointerListType = std::is_base_of<ConcurrentPointerListElement<Ty>, Ty>::value;
+//////////////////////////////////////////////////
+/*
+* element usable in a ConcurrentPointerList
+*/
+template <typename Ty>
+class ConcurrentPointerListElement
+{
+protected:
+	ConcurrentPointerListElement(Ty*);
+public:
+	ConcurrentPointerListElement(const ConcurrentPointerListElement<Ty>&) noexcept;
+	ConcurrentPointerListElement(ConcurrentPointerListElement<Ty>&&) noexcept;
+
+	ConcurrentPointerListElement<Ty>& operator=(const ConcurrentPointerListElement<Ty>&) noexcept;
+	ConcurrentPointerListElement<Ty>& operator=(ConcurrentPointerListElement<Ty>&&) noexcept;
+
+	virtual ~ConcurrentPointerListElement() = 0;
+
+protected:
+	void removefromPointerList();
+	/*
+	* moves the registration of 'other' over to this element (leaving the list this element was in, if any).
+	* waits for a grace period, as readers may still hold the address of 'other'.
+	*/
+	void relocateFrom(ConcurrentPointerListElement<Ty>& other);
+	bool IsInList() const;
+	void setElementPointer(Ty*);
+	friend class ConcurrentPointerList<Ty>;
+	Ty* element = nullptr;
+	std::atomic<ConcurrentPointerList<Ty>*> owner_list = nullptr; // list the element is currently registered in
+	size_t slot_index = 0; // position of 'element' in the owner's pointer-array, guarded by the owner's mutex
+};
+//////////////////////////////////////////////////
+/*
+* data structure that holds a list of pointers of type 'Ty' which can be
+* modified and iterated from multiple threads at once.
+* 
+* inherit 'public ConcurrentPointerListElement<YourType>' to make your type usable in the list.
+* same rules as for the PointerList apply: no duplicates, one object can only be part of one list.
+*/
+template <typename Ty>
+class ConcurrentPointerList
+{
+public:
+	/*
+	* immutable view of the list at one point in time.
+	* holding it keeps every element in it from being unregistered/destroyed.
+	*/
+	class snapshot
+	{
+	public:
+		using const_iterator = typename std::vector<Ty*>::const_iterator;
+
+		const_iterator begin() const;
+		const_iterator end() const;
+		size_t size() const;
+		Ty* operator[](size_t) const;
+
+	private:
+		friend class ConcurrentPointerList<Ty>;
+		explicit snapshot(std::shared_ptr<const std::vector<Ty*>>);
+		std::shared_ptr<const std::vector<Ty*>> pointers;
+	};
+
+	ConcurrentPointerList();
+
+	ConcurrentPointerList(const ConcurrentPointerList<Ty>&) = delete;
+	ConcurrentPointerList<Ty>& operator=(const ConcurrentPointerList<Ty>&) = delete;
+
+	~ConcurrentPointerList();
+	/*
+	* adds element to the list
+	*
+	* returns 'false' if element was already in a list.
+	* returns 'true' on success.
+	*/
+	bool addElement(Ty&);
+	/*
+	* removes element from the list and waits until no reader can see it anymore
+	*
+	* returns 'false' if element was not in the list.
+	* returns 'true' on success.
+	*/
+	bool removeElement(Ty&);
+	bool ElementInList(const Ty&) const;
+	/*
+	* lock-free read access, see 'snapshot'
+	*/
+	snapshot read() const;
+	size_t size() const;
+	void reserve(size_t);
+
+private:
+	friend class ConcurrentPointerListElement<Ty>;
+	/*
+	* entry points for ConcurrentPointerListElement, take the lock themselves
+	*/
+	bool detach(ConcurrentPointerListElement<Ty>&);
+	void relocate(ConcurrentPointerListElement<Ty>& from, ConcurrentPointerListElement<Ty>& to);
+	void repoint(ConcurrentPointerListElement<Ty>&, Ty*);
+	/*
+	* the following expect 'write_mutex' to be held
+	*/
+	void removeSlot(size_t slot);
+	void publish();
+	/*
+	* blocks until every retired snapshot has been released by its readers
+	*/
+	void synchronize(std::unique_lock<std::mutex>&);
+
+	mutable std::mutex write_mutex;
+	std::vector<Ty*> pointer_list; // writer-side dense slot array
+	std::atomic<std::shared_ptr<const std::vector<Ty*>>> published;
+	std::vector<std::weak_ptr<const std::vector<Ty*>>> retired; // snapshots readers may still hold
+};
+//////////////////////////////////////////////////
+#include "ConcurrentPointerList_Definitions.hpp"
+//////////////////////////////////////////////////
+#endif
+//////////////////////////////////////////////////
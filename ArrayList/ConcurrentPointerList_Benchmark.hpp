@@ -0,0 +1,156 @@
+//////////////////////////////////////////////////
+#ifndef CONCURRENTPOINTERLIST_BENCHMARK_H
+#define CONCURRENTPOINTERLIST_BENCHMARK_H
+//////////////////////////////////////////////////
+#include "ConcurrentPointerList.hpp"
+#include "PointerList.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+//////////////////////////////////////////////////
+/*
+* reader/writer throughput of the ConcurrentPointerList against a PointerList guarded by
+* a std::shared_mutex (readers take the shared lock for one pass, writers the exclusive lock).
+* 
+* 'readers' threads iterate the whole list and sum a value per element while 'writers' threads
+* keep adding and removing elements of their own for 'duration'. prints elements visited and
+* write operations per second for each writer count from 0 to 'writers'.
+* 
+* EXAMPLE:
+* 
+* int main() { ConcurrentPointerListBenchmark(); }
+* 
+*/
+//////////////////////////////////////////////////
+struct ConcurrentPointerListBenchmarkElement : public ConcurrentPointerListElement<ConcurrentPointerListBenchmarkElement>
+{
+	explicit ConcurrentPointerListBenchmarkElement(uint64_t val)
+		: ConcurrentPointerListElement<ConcurrentPointerListBenchmarkElement>(this), value(val) {}
+	~ConcurrentPointerListBenchmarkElement() { removefromPointerList(); }
+	uint64_t value;
+};
+
+struct PointerListBenchmarkElement : public PointerListElement<PointerListBenchmarkElement>
+{
+	explicit PointerListBenchmarkElement(uint64_t val)
+		: PointerListElement<PointerListBenchmarkElement>(this), value(val) {}
+	uint64_t value;
+};
+//////////////////////////////////////////////////
+struct ConcurrentPointerListBenchmarkResult
+{
+	double reads_per_second = 0.0; // elements visited
+	double writes_per_second = 0.0; // adds + removes
+};
+//////////////////////////////////////////////////
+/*
+* runs 'readers' readers and 'writers' writers against one list for 'duration'.
+* 'read_pass(checksum)' iterates the list once and returns the number of elements visited,
+* 'write_pair(value)' adds one element and removes it again.
+*/
+template <typename ReadPass, typename WritePair>
+inline ConcurrentPointerListBenchmarkResult ConcurrentPointerListBenchmarkRun(size_t readers, size_t writers, std::chrono::milliseconds duration, ReadPass&& read_pass, WritePair&& write_pair)
+{
+	std::atomic<bool> stop = false;
+	std::atomic<uint64_t> visited = 0;
+	std::atomic<uint64_t> written = 0;
+	std::atomic<uint64_t> checksum = 0;
+	std::vector<std::thread> threads;
+	for (size_t r = 0; r < readers; ++r)
+	{
+		threads.emplace_back([&]() {
+			uint64_t local_visited = 0;
+			uint64_t local_checksum = 0;
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				local_visited += read_pass(local_checksum);
+			}
+			visited += local_visited;
+			checksum += local_checksum;
+		});
+	}
+	for (size_t w = 0; w < writers; ++w)
+	{
+		threads.emplace_back([&, w]() {
+			uint64_t local_written = 0;
+			while (!stop.load(std::memory_order_relaxed))
+			{
+				write_pair(w + local_written);
+				local_written += 2;
+			}
+			written += local_written;
+		});
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::this_thread::sleep_for(duration);
+	stop = true;
+	for (std::thread& thread : threads)
+	{
+		thread.join();
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (checksum.load() == 1) // keeps the reads from being optimized away
+		printf("\n");
+	return ConcurrentPointerListBenchmarkResult{ static_cast<double>(visited.load()) / seconds, static_cast<double>(written.load()) / seconds };
+}
+//////////////////////////////////////////////////
+inline void ConcurrentPointerListBenchmark(size_t readers = 4, size_t writers = 2, size_t elements = 10000, std::chrono::milliseconds duration = std::chrono::milliseconds(500))
+{
+	printf("ConcurrentPointerList benchmark: %zu readers, %zu elements, %lld ms per run\n", readers, elements, static_cast<long long>(duration.count()));
+	printf("%-8s | %-36s | %14s | %14s\n", "writers", "list", "reads/s", "writes/s");
+
+	for (size_t w = 0; w <= writers; ++w)
+	{
+		{
+			ConcurrentPointerList<ConcurrentPointerListBenchmarkElement> list;
+			std::vector<std::unique_ptr<ConcurrentPointerListBenchmarkElement>> base;
+			for (size_t i = 0; i < elements; ++i)
+			{
+				base.emplace_back(std::make_unique<ConcurrentPointerListBenchmarkElement>(i));
+				list.addElement(*base.back());
+			}
+			ConcurrentPointerListBenchmarkResult result = ConcurrentPointerListBenchmarkRun(readers, w, duration,
+				[&](uint64_t& checksum) {
+					ConcurrentPointerList<ConcurrentPointerListBenchmarkElement>::snapshot snapshot = list.read();
+					for (const ConcurrentPointerListBenchmarkElement* ptr : snapshot) { checksum += ptr->value; }
+					return snapshot.size();
+				},
+				[&](uint64_t value) {
+					ConcurrentPointerListBenchmarkElement element(value);
+					list.addElement(element);
+				});
+			printf("%-8zu | %-36s | %14.0f | %14.0f\n", w, "ConcurrentPointerList", result.reads_per_second, result.writes_per_second);
+		}
+		{
+			PointerList<PointerListBenchmarkElement> list;
+			std::shared_mutex mutex;
+			std::vector<std::unique_ptr<PointerListBenchmarkElement>> base;
+			for (size_t i = 0; i < elements; ++i)
+			{
+				base.emplace_back(std::make_unique<PointerListBenchmarkElement>(i));
+				list.addElement(*base.back());
+			}
+			ConcurrentPointerListBenchmarkResult result = ConcurrentPointerListBenchmarkRun(readers, w, duration,
+				[&](uint64_t& checksum) {
+					std::shared_lock<std::shared_mutex> lock(mutex);
+					for (const PointerListBenchmarkElement* ptr : list.get()) { checksum += ptr->value; }
+					return list.size();
+				},
+				[&](uint64_t value) {
+					PointerListBenchmarkElement element(value);
+					std::unique_lock<std::shared_mutex> lock(mutex);
+					list.addElement(element);
+					list.removeElement(element);
+				});
+			printf("%-8zu | %-36s | %14.0f | %14.0f\n", w, "PointerList + std::shared_mutex", result.reads_per_second, result.writes_per_second);
+		}
+	}
+}
+//////////////////////////////////////////////////
+#endif
+//////////////////////////////////////////////////
@@ -0,0 +1,256 @@
+//////////////////////////////////////////////////
+template <typename Ty>
+ConcurrentPointerListElement<Ty>::ConcurrentPointerListElement(Ty* ptr)
+{
+	setElementPointer(ptr);
+}
+
+template <typename Ty>
+ConcurrentPointerListElement<Ty>::ConcurrentPointerListElement(const ConcurrentPointerListElement<Ty>&) noexcept
+{
+	this->owner_list = nullptr;
+}
+
+template <typename Ty>
+ConcurrentPointerListElement<Ty>::ConcurrentPointerListElement(ConcurrentPointerListElement<Ty>&&) noexcept
+{
+	this->owner_list = nullptr; // registration is taken over with relocateFrom() once the derived object is complete
+}
+
+template <typename Ty>
+ConcurrentPointerListElement<Ty>& ConcurrentPointerListElement<Ty>::operator=(const ConcurrentPointerListElement<Ty>&) noexcept
+{
+	return *this;
+}
+
+template <typename Ty>
+ConcurrentPointerListElement<Ty>& ConcurrentPointerListElement<Ty>::operator=(ConcurrentPointerListElement<Ty>&&) noexcept
+{
+	return *this;
+}
+
+template <typename Ty>
+ConcurrentPointerListElement<Ty>::~ConcurrentPointerListElement()
+{
+	removefromPointerList();
+}
+
+template <typename Ty>
+void ConcurrentPointerListElement<Ty>::removefromPointerList()
+{
+	if (ConcurrentPointerList<Ty>* list = owner_list.load())
+	{
+		list->detach(*this);
+	}
+}
+
+template <typename Ty>
+void ConcurrentPointerListElement<Ty>::relocateFrom(ConcurrentPointerListElement<Ty>& other)
+{
+	if (this == &other)
+		return;
+	removefromPointerList();
+	if (ConcurrentPointerList<Ty>* list = other.owner_list.load())
+	{
+		list->relocate(other, *this);
+	}
+}
+
+template <typename Ty>
+bool ConcurrentPointerListElement<Ty>::IsInList() const
+{
+	if (owner_list.load())
+		return true;
+	return false;
+}
+
+template <typename Ty>
+void ConcurrentPointerListElement<Ty>::setElementPointer(Ty* ptr)
+{
+	if (ConcurrentPointerList<Ty>* list = owner_list.load())
+	{
+		list->repoint(*this, ptr);
+	}
+	else
+	{
+		this->element = ptr;
+	}
+}
+
+//////////////////////////////////////////////////
+
+template <typename Ty>
+typename ConcurrentPointerList<Ty>::snapshot::const_iterator ConcurrentPointerList<Ty>::snapshot::begin() const
+{
+	return pointers->cbegin();
+}
+
+template <typename Ty>
+typename ConcurrentPointerList<Ty>::snapshot::const_iterator ConcurrentPointerList<Ty>::snapshot::end() const
+{
+	return pointers->cend();
+}
+
+template <typename Ty>
+size_t ConcurrentPointerList<Ty>::snapshot::size() const
+{
+	return pointers->size();
+}
+
+template <typename Ty>
+Ty* ConcurrentPointerList<Ty>::snapshot::operator[](size_t index) const
+{
+	return (*pointers)[index];
+}
+
+template <typename Ty>
+ConcurrentPointerList<Ty>::snapshot::snapshot(std::shared_ptr<const std::vector<Ty*>> ptr)
+	: pointers(std::move(ptr))
+{
+
+}
+
+//////////////////////////////////////////////////
+
+template <typename Ty>
+ConcurrentPointerList<Ty>::ConcurrentPointerList()
+	: published(std::make_shared<const std::vector<Ty*>>())
+{
+
+}
+
+template <typename Ty>
+ConcurrentPointerList<Ty>::~ConcurrentPointerList()
+{
+	std::lock_guard<std::mutex> lock(write_mutex);
+	for (Ty* ptr : pointer_list)
+	{
+		ptr->owner_list = nullptr;
+	}
+}
+
+template <typename Ty>
+bool ConcurrentPointerList<Ty>::addElement(Ty& element)
+{
+	static_assert(ConcurrentPointerListType<Ty>, "Ty has to inherit ConcurrentPointerListElement<Ty>");
+	std::lock_guard<std::mutex> lock(write_mutex);
+	ConcurrentPointerList<Ty>* expected = nullptr;
+	if (!element.owner_list.compare_exchange_strong(expected, this))
+		return false; // element is already in a list and thus can't be added to another.
+	pointer_list.emplace_back(element.element);
+	element.slot_index = pointer_list.size() - 1;
+	publish();
+	return true;
+}
+
+template <typename Ty>
+bool ConcurrentPointerList<Ty>::removeElement(Ty& element)
+{
+	return detach(element);
+}
+
+template <typename Ty>
+bool ConcurrentPointerList<Ty>::ElementInList(const Ty& element) const
+{
+	return element.owner_list.load() == this;
+}
+
+template <typename Ty>
+typename ConcurrentPointerList<Ty>::snapshot ConcurrentPointerList<Ty>::read() const
+{
+	return snapshot(published.load(std::memory_order_acquire));
+}
+
+template <typename Ty>
+size_t ConcurrentPointerList<Ty>::size() const
+{
+	return published.load(std::memory_order_acquire)->size();
+}
+
+template <typename Ty>
+void ConcurrentPointerList<Ty>::reserve(size_t new_capacity)
+{
+	std::lock_guard<std::mutex> lock(write_mutex);
+	pointer_list.reserve(new_capacity);
+}
+
+template <typename Ty>
+bool ConcurrentPointerList<Ty>::detach(ConcurrentPointerListElement<Ty>& element)
+{
+	std::unique_lock<std::mutex> lock(write_mutex);
+	if (element.owner_list.load() != this)
+		return false; // element not in list
+	removeSlot(element.slot_index);
+	element.owner_list = nullptr;
+	publish();
+	synchronize(lock);
+	return true;
+}
+
+template <typename Ty>
+void ConcurrentPointerList<Ty>::relocate(ConcurrentPointerListElement<Ty>& from, ConcurrentPointerListElement<Ty>& to)
+{
+	std::unique_lock<std::mutex> lock(write_mutex);
+	if (from.owner_list.load() != this)
+		return;
+	to.slot_index = from.slot_index;
+	to.owner_list = this;
+	from.owner_list = nullptr;
+	pointer_list[to.slot_index] = to.element;
+	publish();
+	synchronize(lock); // readers may still hold the old address
+}
+
+template <typename Ty>
+void ConcurrentPointerList<Ty>::repoint(ConcurrentPointerListElement<Ty>& element, Ty* ptr)
+{
+	std::unique_lock<std::mutex> lock(write_mutex);
+	element.element = ptr;
+	if (element.owner_list.load() != this)
+		return;
+	pointer_list[element.slot_index] = ptr;
+	publish();
+	synchronize(lock);
+}
+
+template <typename Ty>
+void ConcurrentPointerList<Ty>::removeSlot(size_t slot)
+{
+	// swap-and-pop: the last pointer takes over the freed slot
+	Ty* last = pointer_list.back();
+	if (slot != pointer_list.size() - 1)
+	{
+		pointer_list[slot] = last;
+		last->slot_index = slot;
+	}
+	pointer_list.pop_back();
+}
+
+template <typename Ty>
+void ConcurrentPointerList<Ty>::publish()
+{
+	std::shared_ptr<const std::vector<Ty*>> old = published.exchange(
+		std::make_shared<const std::vector<Ty*>>(pointer_list), std::memory_order_acq_rel);
+	// drop retired snapshots that no reader holds anymore
+	std::erase_if(retired, [](const std::weak_ptr<const std::vector<Ty*>>& wptr) { return wptr.expired(); });
+	retired.emplace_back(old);
+}
+
+template <typename Ty>
+void ConcurrentPointerList<Ty>::synchronize(std::unique_lock<std::mutex>& lock)
+{
+	// every snapshot published before the last change is waited for, not only the latest one,
+	// since a slow reader may still hold an older snapshot containing the same pointer.
+	// waiting happens outside the lock so other writers are not held up by slow readers.
+	std::vector<std::weak_ptr<const std::vector<Ty*>>> pending = retired;
+	lock.unlock();
+	for (const std::weak_ptr<const std::vector<Ty*>>& wptr : pending)
+	{
+		while (!wptr.expired())
+		{
+			std::this_thread::yield();
+		}
+	}
+}
+
+//////////////////////////////////////////////////
@@ -0,0 +1,174 @@
+//////////////////////////////////////////////////
+#ifndef CONCURRENTPOINTERLIST_STRESSTEST_H
+#define CONCURRENTPOINTERLIST_STRESSTEST_H
+//////////////////////////////////////////////////
+#include "ConcurrentPointerList.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+//////////////////////////////////////////////////
+/*
+* multithreaded stress test of the ConcurrentPointerList.
+* 
+* 'readers' threads iterate 'read()' snapshots and call into every element while
+* 'writers' threads add, move (construct and assign) and destroy their own elements.
+* every element carries a marker that its destructor clears, a reader finding a cleared
+* marker has seen an element after its grace period ended. build with
+* -fsanitize=thread or -fsanitize=address to also catch races and use-after-free.
+* ThreadSanitizer does not model the lock inside libstdc++'s std::atomic<std::shared_ptr>,
+* run it with a suppression for 'race:std::_Sp_atomic'.
+* 
+* returns the number of errors found, '0' on success.
+* 
+* EXAMPLE:
+* 
+* int main() { return ConcurrentPointerListStressTest() != 0; }
+* 
+*/
+//////////////////////////////////////////////////
+struct ConcurrentPointerListStressElement : public ConcurrentPointerListElement<ConcurrentPointerListStressElement>
+{
+	static constexpr uint64_t alive_marker = 0xA11CE5A11CE5A11CULL;
+
+	explicit ConcurrentPointerListStressElement(uint64_t val)
+		: ConcurrentPointerListElement<ConcurrentPointerListStressElement>(this), value(val) {}
+	ConcurrentPointerListStressElement(ConcurrentPointerListStressElement&& other)
+		: ConcurrentPointerListElement<ConcurrentPointerListStressElement>(this), value(other.value.load())
+	{
+		relocateFrom(other);
+	}
+	ConcurrentPointerListStressElement& operator=(ConcurrentPointerListStressElement&& other)
+	{
+		value = other.value.load();
+		relocateFrom(other);
+		return *this;
+	}
+	~ConcurrentPointerListStressElement()
+	{
+		removefromPointerList();
+		marker = 0;
+	}
+	/*
+	* called by the readers, 'false' if the element was already destroyed
+	*/
+	bool visit(uint64_t& checksum) const
+	{
+		checksum += value.load(std::memory_order_relaxed);
+		return marker.load(std::memory_order_relaxed) == alive_marker;
+	}
+
+	std::atomic<uint64_t> marker = alive_marker;
+	std::atomic<uint64_t> value;
+};
+//////////////////////////////////////////////////
+inline size_t ConcurrentPointerListStressTest(size_t readers = 4, size_t writers = 4, size_t operations = 2000, size_t max_elements = 64)
+{
+	using Element = ConcurrentPointerListStressElement;
+	ConcurrentPointerList<Element> list;
+	std::atomic<size_t> errors = 0;
+	std::atomic<size_t> snapshots = 0;
+	std::atomic<bool> stop = false;
+	std::atomic<size_t> live = 0;
+
+	std::vector<std::thread> reader_threads;
+	for (size_t r = 0; r < readers; ++r)
+	{
+		reader_threads.emplace_back([&]() {
+			uint64_t checksum = 0;
+			while (!stop.load())
+			{
+				for (const Element* ptr : list.read())
+				{
+					if (!ptr->visit(checksum))
+						++errors;
+				}
+				++snapshots;
+			}
+			if (checksum == 1) // keeps the visits from being optimized away
+				printf("\n");
+		});
+	}
+
+	std::vector<std::vector<std::unique_ptr<Element>>> owned(writers);
+	std::vector<std::thread> writer_threads;
+	for (size_t w = 0; w < writers; ++w)
+	{
+		writer_threads.emplace_back([&, w]() {
+			std::vector<std::unique_ptr<Element>>& elements = owned[w];
+			std::mt19937_64 engine(w + 1);
+			for (size_t i = 0; i < operations; ++i)
+			{
+				size_t action = elements.empty() ? 0 : engine() % 4;
+				if (elements.size() >= max_elements)
+					action = 3;
+				size_t index = elements.empty() ? 0 : engine() % elements.size();
+				switch (action)
+				{
+				case 0: // add
+					elements.emplace_back(std::make_unique<Element>(engine()));
+					if (!list.addElement(*elements.back()))
+						++errors;
+					++live;
+					break;
+				case 1: // move construct into a new allocation, free the moved-from element
+					elements[index] = std::make_unique<Element>(std::move(*elements[index]));
+					break;
+				case 2: // move assign onto another element, which leaves the list, free the moved-from element
+				{
+					size_t target = engine() % elements.size();
+					if (target != index)
+					{
+						*elements[target] = std::move(*elements[index]);
+						elements[index] = std::move(elements.back());
+						elements.pop_back();
+						--live; // the target takes over the slot of the moved-from element
+					}
+					break;
+				}
+				case 3: // destroy
+					elements[index] = std::move(elements.back());
+					elements.pop_back();
+					--live;
+					break;
+				}
+			}
+		});
+	}
+
+	for (std::thread& thread : writer_threads)
+	{
+		thread.join();
+	}
+	// quiescent point: every element still owned has to be in the list exactly once
+	size_t in_list = 0;
+	for (const std::vector<std::unique_ptr<Element>>& elements : owned)
+	{
+		for (const std::unique_ptr<Element>& element : elements)
+		{
+			if (list.ElementInList(*element))
+				++in_list;
+		}
+	}
+	if (in_list != live.load() || list.size() != live.load())
+		++errors;
+	owned.clear();
+	stop = true;
+	for (std::thread& thread : reader_threads)
+	{
+		thread.join();
+	}
+	if (list.size() != 0)
+		++errors;
+
+	printf("ConcurrentPointerList stress test: %zu readers, %zu writers, %zu operations per writer, %zu snapshots read, %zu errors\n",
+		readers, writers, operations, snapshots.load(), errors.load());
+	return errors.load();
+}
+//////////////////////////////////////////////////
+#endif
+//////////////////////////////////////////////////
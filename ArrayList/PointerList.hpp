@@ -2,7 +2,8 @@
 #ifndef POINTERLIST_H
 #define POINTERLIST_H
 //////////////////////////////////////////////////
-#include <list>
+#include <vector>
+#include <cstddef>
 #include <concepts>
 #include <type_traits>
 //////////////////////////////////////////////////
@@ -17,10 +18,11 @@
 * when a 'PointerListElement<Type>' gets moved or destroyed, the corresponding list which
 * that the element was part of gets notified of the new memory location or destruction
 * 
-* in such a case, the list CAN hold nullptrs. always check before using pointers of a PointerList
-* or call 'PointerList<Type>::verify()' before. this pulls out any nullptrs in the list.
+* internally the list is a dense array of pointers and every element remembers its slot in it.
+* adding, removing and relocating an element therefore are O(1) operations. removal swaps the
+* last pointer into the freed slot, so the order of the list is not preserved on removal.
 * 
-* this ensures that no corruption is happening due to the element going out of scope or being moved.
+* the list never holds nullptrs, a destroyed element is removed from it immediately.
 * 
 * if the list were to go out of scope before its elements, the respective pointers of all of its elements will be set to null.
 *
@@ -75,14 +77,14 @@ protected:
 	void removefromPointerList();
 	bool IsInList() const;
 	void setElementPointer(Ty*);
-	friend PointerList;
+	template <PointerListType> friend class PointerList;
 	Ty* element = nullptr;
-	Ty** element_in_ptrlist = nullptr;
+	std::vector<Ty*>* owner_list = nullptr; // pointer-array of the list the element is currently registered in
+	size_t slot_index = 0; // position of 'element' in 'owner_list'
 };
 //////////////////////////////////////////////////
 /*
-* data structure that holds a list of pointers of type 'Ty'.
-* automatically deletes nullptrs out of the list with the call of Pointerlist::verify()
+* data structure that holds a contiguous list of pointers of type 'Ty'.
 * 
 * is intended to be used along with PointerListElement, which automatically manages copying, moving
 * and destructing operations for this list to prevent undefined behaviour.
@@ -122,14 +124,22 @@ public:
 	bool removeElement(Ty&);
 	bool ElementInList(Ty&);
 
-	std::list<Ty*> get();
-	std::list<Ty*>::iterator begin();
-	std::list<Ty*>::iterator end();
-	size_t size();
-
+	const std::vector<Ty*>& get() const;
+	typename std::vector<Ty*>::iterator begin();
+	typename std::vector<Ty*>::iterator end();
+	size_t size() const;
+	void reserve(size_t);
+	/*
+	* kept for compatibility. the list is always free of nullptrs,
+	* so there is nothing left to sweep.
+	*/
 	void verify();
 private:
-	std::list<Ty*> pointer_list;
+	/*
+	* re-points every registered element to this list (after the storage was moved in)
+	*/
+	void adoptElements();
+	std::vector<Ty*> pointer_list;
 };
 //////////////////////////////////////////////////
 #include "PointerList_Definitions.hpp"
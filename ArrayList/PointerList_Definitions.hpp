@@ -8,37 +8,46 @@ PointerListElement<Ty>::PointerListElement(Ty* ptr)
 template <typename Ty>
 PointerListElement<Ty>::PointerListElement(const PointerListElement<Ty>&) noexcept
 {
-	this->element_in_ptrlist = nullptr;
+	this->owner_list = nullptr;
 }
 
 template <typename Ty>
 PointerListElement<Ty>::PointerListElement(PointerListElement<Ty>&& other) noexcept
 {
-	removefromPointerList();
-	if (other.element_in_ptrlist)
+	// the derived object is still under construction here. its address follows from the
+	// fixed offset between 'Ty' and this base, taken from the moved-from object.
+	if (other.element)
+	{
+		const std::ptrdiff_t offset = reinterpret_cast<const char*>(other.element) - reinterpret_cast<const char*>(&other);
+		setElementPointer(reinterpret_cast<Ty*>(reinterpret_cast<char*>(this) + offset));
+	}
+	if (other.owner_list)
 	{
-		*other.element_in_ptrlist = other.element;
-		this->element_in_ptrlist = other.element_in_ptrlist;
-		other.element_in_ptrlist = nullptr;
+		this->owner_list = other.owner_list;
+		this->slot_index = other.slot_index;
+		(*this->owner_list)[this->slot_index] = this->element;
+		other.owner_list = nullptr;
 	}
 }
 
 template <typename Ty>
 PointerListElement<Ty>& PointerListElement<Ty>::operator=(const PointerListElement<Ty>&) noexcept
 {
-	this->element_in_ptrlist = nullptr;
 	return *this;
 }
 
 template <typename Ty>
 PointerListElement<Ty>& PointerListElement<Ty>::operator=(PointerListElement<Ty>&& other) noexcept
 {
+	if (this == &other)
+		return *this;
 	removefromPointerList();
-	if (other.element_in_ptrlist)
+	if (other.owner_list)
 	{
-		*other.element_in_ptrlist = other.element;
-		this->element_in_ptrlist = other.element_in_ptrlist;
-		other.element_in_ptrlist = nullptr;
+		this->owner_list = other.owner_list;
+		this->slot_index = other.slot_index;
+		(*this->owner_list)[this->slot_index] = this->element;
+		other.owner_list = nullptr;
 	}
 	return *this;
 }
@@ -52,17 +61,25 @@ PointerListElement<Ty>::~PointerListElement()
 template <typename Ty>
 void PointerListElement<Ty>::removefromPointerList()
 {
-	if (element_in_ptrlist)
+	if (owner_list)
 	{
-		*element_in_ptrlist = nullptr;
-		element_in_ptrlist = nullptr;
+		// swap-and-pop: the last pointer takes over the freed slot
+		std::vector<Ty*>& slots = *owner_list;
+		Ty* last = slots.back();
+		if (last != element)
+		{
+			slots[slot_index] = last;
+			last->slot_index = slot_index;
+		}
+		slots.pop_back();
+		owner_list = nullptr;
 	}
 }
 
 template <typename Ty>
 bool PointerListElement<Ty>::IsInList() const
 {
-	if (element_in_ptrlist)
+	if (owner_list)
 		return true;
 	return false;
 }
@@ -71,6 +88,10 @@ template <typename Ty>
 void PointerListElement<Ty>::setElementPointer(Ty* ptr)
 {
 	this->element = ptr;
+	if (owner_list)
+	{
+		(*owner_list)[slot_index] = ptr;
+	}
 }
 
 //////////////////////////////////////////////////
@@ -83,23 +104,30 @@ PointerList<Ty>::PointerList(const PointerList&) noexcept
 
 template <PointerListType Ty>
 PointerList<Ty>::PointerList(PointerList&& other) noexcept
+	: pointer_list(std::move(other.pointer_list))
 {
-	this->pointer_list = other.pointer_list;
 	other.pointer_list.clear();
+	adoptElements();
 }
 
 template <PointerListType Ty>
 PointerList<Ty>& PointerList<Ty>::operator=(const PointerList<Ty>&) noexcept
 {
-	this->pointer_list.clear();
 	return *this;
 }
 
 template <PointerListType Ty>
 PointerList<Ty>& PointerList<Ty>::operator=(PointerList&& other) noexcept
 {
-	this->pointer_list = other.pointer_list;
+	if (this == &other)
+		return *this;
+	for (Ty* ptr : pointer_list)
+	{
+		ptr->owner_list = nullptr;
+	}
+	this->pointer_list = std::move(other.pointer_list);
 	other.pointer_list.clear();
+	adoptElements();
 	return *this;
 }
 
@@ -108,10 +136,7 @@ PointerList<Ty>::~PointerList()
 {
 	for (Ty* ptr : pointer_list)
 	{
-		if (ptr)
-		{
-			ptr->element_in_ptrlist = nullptr;
-		}
+		ptr->owner_list = nullptr;
 	}
 }
 
@@ -121,7 +146,8 @@ bool PointerList<Ty>::addElement(Ty& element)
 	if (element.IsInList())
 		return false; // element is already in a list and thus can't be added to another.
 	pointer_list.emplace_back(&element);
-	element.element_in_ptrlist = &pointer_list.back();
+	element.owner_list = &pointer_list;
+	element.slot_index = pointer_list.size() - 1;
 	return true;
 }
 
@@ -130,69 +156,59 @@ bool PointerList<Ty>::removeElement(Ty& element)
 {
 	if (!ElementInList(element))
 		return false; // element not in list
-	for (typename std::list<Ty*>::iterator iter = pointer_list.begin(); iter != pointer_list.end(); iter++)
-	{
-		if ((*iter) == &element)
-		{
-			pointer_list.erase(iter);
-			element.element_in_ptrlist = nullptr;
-			break;
-		}
-	}
+	element.removefromPointerList();
 	return true;
 }
 
 template <PointerListType Ty>
 bool PointerList<Ty>::ElementInList(Ty& element)
 {
-	for (typename std::list<Ty*>::iterator iter = pointer_list.begin(); iter != pointer_list.end(); iter++)
-	{
-		if ((*iter) == &element)
-		{
-			return true;
-		}
-	}
-	return false;
+	return element.owner_list == &pointer_list;
 }
 
 template<PointerListType Ty>
-std::list<Ty*> PointerList<Ty>::get()
+const std::vector<Ty*>& PointerList<Ty>::get() const
 {
 	return pointer_list;
 }
 
 template<PointerListType Ty>
-std::list<Ty*>::iterator PointerList<Ty>::begin()
+typename std::vector<Ty*>::iterator PointerList<Ty>::begin()
 {
 	return pointer_list.begin();
 }
 
 template<PointerListType Ty>
-std::list<Ty*>::iterator PointerList<Ty>::end()
+typename std::vector<Ty*>::iterator PointerList<Ty>::end()
 {
 	return pointer_list.end();
 }
 
 template<PointerListType Ty>
-size_t PointerList<Ty>::size()
+size_t PointerList<Ty>::size() const
 {
 	return pointer_list.size();
 }
 
+template<PointerListType Ty>
+void PointerList<Ty>::reserve(size_t new_capacity)
+{
+	pointer_list.reserve(new_capacity);
+}
+
 template <PointerListType Ty>
 void PointerList<Ty>::verify()
 {
-	for (typename std::list<Ty*>::iterator iter = pointer_list.begin(); iter != pointer_list.end();)
+
+}
+
+template <PointerListType Ty>
+void PointerList<Ty>::adoptElements()
+{
+	for (Ty* ptr : pointer_list)
 	{
-		if (*iter)
-		{
-			iter++;
-		}
-		else
-		{
-			iter = pointer_list.erase(iter);
-		}
+		ptr->owner_list = &pointer_list;
 	}
 }
 
-//////////////////////////////////////////////////
\ No newline at end of file
+//////////////////////////////////////////////////
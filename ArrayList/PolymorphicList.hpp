@@ -7,6 +7,7 @@
 #include <vector>
 #include <memory>
 #include <stdexcept>
+#include <utility>
 //////////////////////////////////////////////////
 /*
 * 
@@ -16,6 +17,7 @@
 * 
 * always copies the passed object into the heap
 * using 'std::make_unique<_Ty>(obj)'
+* or constructs it there in-place with 'emplace_back<_Ty>(args...)'
 * 
 * to ensure your type is polymorphically copyable,
 * you need to define a clone() function for
@@ -49,13 +51,22 @@ class PolymorphicList
 {
 public:
 	PolymorphicList() = default;
-	PolymorphicList(const PolymorphicList<Ty>&) noexcept;
+	PolymorphicList(const PolymorphicList<Ty>&); // copies clone every element, which may throw
 	PolymorphicList(PolymorphicList<Ty>&&) noexcept;
-	PolymorphicList<Ty>& operator=(const PolymorphicList&) noexcept;
+	PolymorphicList<Ty>& operator=(const PolymorphicList&);
 	PolymorphicList<Ty>& operator=(PolymorphicList&&) noexcept;
 
 	template <std::derived_from<Ty> _Ty>
 	void push_back(const _Ty&);
+	/*
+	* constructs an object of type '_Ty' directly on the heap
+	* from the passed arguments, no temporary is copied.
+	* 
+	* returns reference to the new element.
+	*/
+	template <std::derived_from<Ty> _Ty, typename... Args>
+		requires std::constructible_from<_Ty, Args...>
+	_Ty& emplace_back(Args&&...);
 
 	typedef std::vector<std::unique_ptr<Ty>>::iterator iterator;
 
@@ -67,9 +78,13 @@ public:
 	Ty& back();
 	iterator erase(iterator);
 	void clear();
+	void reserve(size_t);
 	size_t size() const;
+	size_t capacity() const;
 
 private:
+	void clone_from(const PolymorphicList<Ty>&);
+
 	std::vector<std::unique_ptr<Ty>> internal_vec;
 };
 
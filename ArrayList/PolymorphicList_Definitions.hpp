@@ -1,36 +1,50 @@
 //////////////////////////////////////////////////
 
 template <typename Ty>
-PolymorphicList<Ty>::PolymorphicList(const PolymorphicList<Ty>& other) noexcept
+PolymorphicList<Ty>::PolymorphicList(const PolymorphicList<Ty>& other)
 {
-	for (const std::unique_ptr<Ty>& ptr : other.internal_vec)
-	{
-		this->internal_vec.emplace_back(ptr->clone());
-	}
+	clone_from(other);
 }
 template <typename Ty>
 PolymorphicList<Ty>::PolymorphicList(PolymorphicList<Ty>&& other) noexcept
+	: internal_vec(std::move(other.internal_vec))
 {
-	this->internal_vec = other.internal_vec;
 	other.internal_vec.clear();
 }
 template <typename Ty>
-PolymorphicList<Ty>& PolymorphicList<Ty>::operator=(const PolymorphicList& other) noexcept
+PolymorphicList<Ty>& PolymorphicList<Ty>::operator=(const PolymorphicList& other)
 {
-	for (const std::unique_ptr<Ty>& ptr : other.internal_vec)
+	if (this != &other)
 	{
-		this->internal_vec.emplace_back(ptr->clone());
+		clone_from(other);
 	}
 	return *this;
 }
 template <typename Ty>
 PolymorphicList<Ty>& PolymorphicList<Ty>::operator=(PolymorphicList&& other) noexcept
 {
-	this->internal_vec = other.internal_vec;
-	other.internal_vec.clear();
+	if (this != &other)
+	{
+		this->internal_vec = std::move(other.internal_vec);
+		other.internal_vec.clear();
+	}
 	return *this;
 }
 
+template <typename Ty>
+void PolymorphicList<Ty>::clone_from(const PolymorphicList<Ty>& other)
+{
+	// build the copy aside and allocate the pointer-storage only once,
+	// so a throwing clone() leaves this list untouched
+	std::vector<std::unique_ptr<Ty>> cloned;
+	cloned.reserve(other.internal_vec.size());
+	for (const std::unique_ptr<Ty>& ptr : other.internal_vec)
+	{
+		cloned.emplace_back(ptr->clone());
+	}
+	this->internal_vec = std::move(cloned);
+}
+
 template <typename Ty>
 template <std::derived_from<Ty> _Ty>
 void PolymorphicList<Ty>::push_back(const _Ty& elem)
@@ -38,6 +52,17 @@ void PolymorphicList<Ty>::push_back(const _Ty& elem)
 	internal_vec.emplace_back(std::make_unique<_Ty>(elem));
 }
 
+template <typename Ty>
+template <std::derived_from<Ty> _Ty, typename... Args>
+	requires std::constructible_from<_Ty, Args...>
+_Ty& PolymorphicList<Ty>::emplace_back(Args&&... args)
+{
+	std::unique_ptr<_Ty> ptr = std::make_unique<_Ty>(std::forward<Args>(args)...);
+	_Ty& ref = *ptr;
+	internal_vec.emplace_back(std::move(ptr));
+	return ref;
+}
+
 template <typename Ty>
 PolymorphicList<Ty>::iterator PolymorphicList<Ty>::begin()
 {
@@ -99,10 +124,22 @@ void PolymorphicList<Ty>::clear()
 	internal_vec.clear();
 }
 
+template <typename Ty>
+void PolymorphicList<Ty>::reserve(size_t new_capacity)
+{
+	internal_vec.reserve(new_capacity);
+}
+
 template <typename Ty>
 size_t PolymorphicList<Ty>::size() const
 {
 	return internal_vec.size();
 }
 
+template <typename Ty>
+size_t PolymorphicList<Ty>::capacity() const
+{
+	return internal_vec.capacity();
+}
+
 //////////////////////////////////////////////////
\ No newline at end of file
@@ -2,10 +2,26 @@
 #include "Texture.hpp"
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
+#include "../../utilitylib/include/utilitylib/io.hpp"
+#include <climits>
 //////////////////////////////////////////////////
 grx::Texture::Texture(const std::filesystem::path& path, TextureType type)
 {
-	unsigned char* data = stbi_load(path.string().c_str(), &width, &height, &nrChannels, 0);
+	// decode straight from the mapped file instead of letting stb_image read it into its own buffer
+	util::mapped_file file;
+	try
+	{
+		file.open(path, util::mapped_file::mode::read_only, util::mapped_file::access::sequential);
+	}
+	catch (const std::exception&)
+	{
+		throw std::runtime_error("could not load texture at " + path.string());
+	}
+	if (file.empty() || file.size() > INT_MAX)
+	{
+		throw std::runtime_error("could not load texture at " + path.string());
+	}
+	unsigned char* data = stbi_load_from_memory(file.data(), static_cast<int>(file.size()), &width, &height, &nrChannels, 0);
 	if (!data)
 	{
 		throw std::runtime_error("could not load texture at " + path.string());
@@ -81,14 +81,19 @@ bool tcp::Client::sendfile(const std::filesystem::path& path)
 		return false;
 	}
 	std::string recvbuf;
-	utility::bytebuffer filebuf;
-	if (!utility::readfile(path, filebuf))
+	util::mapped_file file;
+	try
+	{
+		// packets are cut straight out of the mapped file, nothing is read into memory up front
+		file.open(path, util::mapped_file::mode::read_only, util::mapped_file::access::sequential);
+	}
+	catch (const std::exception&)
 	{
 		Log("failed to read file");
 		return false;
 	}
 	size_t bytes_sent = 0;
-	size_t file_size = filebuf.size();
+	size_t file_size = file.size();
 	Log("file send request initiated");
 	Log("file size: " + std::to_string(file_size) + " bytes");
 	if (!connection->send("$expect_file$" + std::to_string(file_size), 0, std::chrono::milliseconds(10)))
@@ -109,7 +114,7 @@ bool tcp::Client::sendfile(const std::filesystem::path& path)
 	while (bytes_sent < file_size)
 	{
 		size_t current_bytes_sent = 0;
-		if (!connection->send(utility::to_string(filebuf).substr(bytes_sent, PACKET_SIZE), [&](size_t b)
+		if (!connection->send(file.view().substr(bytes_sent, PACKET_SIZE), [&](size_t b)
 			{
 				current_bytes_sent = b;
 			}, std::chrono::milliseconds(0)))
@@ -8,6 +8,7 @@
 #include <boost/noncopyable.hpp>
 //////////////////////////////////////////////////
 #include "Connection.hpp"
+#include "../../utilitylib/include/utilitylib/io.hpp"
 //////////////////////////////////////////////////
 namespace tcp
 {
@@ -4,6 +4,7 @@
 //////////////////////////////////////////////////
 #include <memory>
 #include <iostream>
+#include <string_view>
 //////////////////////////////////////////////////
 #include <boost/asio.hpp>
 #include <boost/noncopyable.hpp>
@@ -45,7 +46,7 @@ namespace tcp
 		bool valid() const;
 
 		template <typename Rep, typename Period>
-		bool send(const std::string& msg,
+		bool send(std::string_view msg,
 			const std::function<void(size_t)>& complete_callback,
 			std::chrono::duration<Rep, Period> timeout);
 		
@@ -62,7 +63,7 @@ namespace tcp
 	//////////////////////////////////////////////////
 
 	template <typename Rep, typename Period>
-	bool tcp::Connection::send(const std::string& msg,
+	bool tcp::Connection::send(std::string_view msg,
 		const std::function<void(size_t)>& complete_callback,
 		std::chrono::duration<Rep, Period> timeout)
 	{
@@ -73,7 +74,7 @@ namespace tcp
 		SENDING = true;
 		boost::asio::streambuf buffer;
 		buffer.prepare(512U);
-		buffer.sputn(msg.c_str(), msg.size());
+		buffer.sputn(msg.data(), msg.size());
 		boost::asio::async_write(*this->socket, buffer,
 			[&, complete_callback](const boost::system::error_code& err, size_t bytes)
 			{
@@ -120,8 +120,7 @@ bool tcp::Server::receivefile(const std::filesystem::path& write_path)
 			Log("receive file timed out or error -4");
 			return false;
 		}
-		utility::bytebuffer received_data_buf = utility::to_buffer(recvbuf);
-		filebuf.insert(filebuf.cend(), received_data_buf.cbegin(), received_data_buf.cend());
+		filebuf.insert(filebuf.cend(), recvbuf.cbegin(), recvbuf.cend());
 		if (!connection->send("$received_file$" + std::to_string(current_bytes_recv), 0, std::chrono::milliseconds(0)))
 		{
 			Log("receive file timed out or error -5");
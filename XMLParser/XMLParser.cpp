@@ -1,5 +1,6 @@
 ////////////////////////////////////////////////////////////
 #include "XMLParser.hpp"
+#include "../utilitylib/include/utilitylib/io.hpp"
 ////////////////////////////////////////////////////////////
 xml::XMLAttribute::XMLAttribute(std::string name, std::string value) : name(name), value(value)
 {
@@ -269,7 +270,7 @@ std::ostream& xml::operator<<(std::ostream& os, const XMLTree& xml)
 	return os;
 }
 ////////////////////////////////////////////////////////////
-xml::XMLTree xml::XMLParser::parseString(const std::string& str)
+xml::XMLTree xml::XMLParser::parseString(std::string_view str)
 {
 	XMLTree res;
 	RawXML raw;
@@ -348,6 +349,12 @@ xml::XMLTree xml::XMLParser::parseString(const std::string& str)
 		throw std::runtime_error("XML syntax error: couldn't find valid pair of open and close tags");
 	return res;
 }
+xml::XMLTree xml::XMLParser::parseFile(const std::filesystem::path& path)
+{
+	// parsed straight from the mapped pages, the file is read front to back once
+	util::mapped_file file(path, util::mapped_file::mode::read_only, util::mapped_file::access::sequential);
+	return parseString(file.view());
+}
 void xml::XMLParser::RawTag::parseTagContent()
 {
 	bool _PROC_ = false;
@@ -552,7 +559,7 @@ bool xml::XMLParser::RawValue::Validate()
 	else
 		return false;
 }
-void xml::XMLParser::RawXML::parseString(const std::string& string)
+void xml::XMLParser::RawXML::parseString(std::string_view string)
 {
 	ParserState state = START;
 	std::string parse_out;
@@ -8,6 +8,7 @@
 * - processing instructions (<?xml...?>)
 * 
 * use XMLParser::parseXMLString() to parse a string into an XMLTree
+* use XMLParser::parseFile() to parse a file, it is memory-mapped instead of read into a string
 * use XMLTree and XMLTree::AddTag() and the returned XMLTag& as well as it's toString() to construct an XML-message
 */
 ////////////////////////////////////////////////////////////
@@ -15,6 +16,8 @@
 #define XML_PARSER_H
 ////////////////////////////////////////////////////////////
 #include <string>
+#include <string_view>
+#include <filesystem>
 #include <sstream>
 #include <iostream>
 #include <list>
@@ -143,7 +146,8 @@ namespace xml
 	{
 	public:
 		XMLParser() = delete;
-		[[nodiscard]] static XMLTree parseString(const std::string& str);
+		[[nodiscard]] static XMLTree parseString(std::string_view str);
+		[[nodiscard]] static XMLTree parseFile(const std::filesystem::path& path);
 
 	private:
 
@@ -190,7 +194,7 @@ namespace xml
 
 		struct RawXML
 		{
-			void parseString(const std::string& string);
+			void parseString(std::string_view string);
 			void finalize();
 
 			std::list<RawTag> tags;
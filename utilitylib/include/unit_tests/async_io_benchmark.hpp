@@ -0,0 +1,88 @@
+
+#ifndef UTIL_ASYNC_IO_BENCHMARK_HPP
+#define UTIL_ASYNC_IO_BENCHMARK_HPP
+
+#include "../utilitylib/async_io.hpp"
+#include "benchmark_util.hpp"
+#include <string>
+#include <cstdio>
+#include <vector>
+#include <future>
+#include <filesystem>
+
+namespace util
+{
+
+	/*
+	 * reads every file of '_paths' once with the synchronous util::readfile loop and then with util::async_io
+	 * through io_uring (where available) and through the thread_pool fallback
+	 */
+	static inline void _async_io_benchmark_run(const char* _name, const std::vector<std::filesystem::path>& _paths)
+	{
+		std::size_t checksum = 0;
+
+		double sync_ms = _benchmark_ms([&]() {
+			bytebuffer contents;
+			for (const std::filesystem::path& path : _paths)
+			{
+				readfile(path, contents);
+				checksum += contents.size();
+			}
+		});
+		async_io uring_io;
+		double uring_ms = _benchmark_ms([&]() {
+			for (std::future<bytebuffer>& contents : uring_io.read_all(_paths)) { checksum += contents.get().size(); }
+		});
+		async_io pool_io(256, false);
+		double pool_ms = _benchmark_ms([&]() {
+			for (std::future<bytebuffer>& contents : pool_io.read_all(_paths)) { checksum += contents.get().size(); }
+		});
+
+		printf("%-24s | readfile %9.2f ms | async_io (%s) %9.2f ms | async_io (thread_pool) %9.2f ms | (%zu)\n",
+			_name, sync_ms, uring_io.uses_io_uring() ? "io_uring" : "thread_pool", uring_ms, pool_ms, checksum);
+	}
+
+	/*
+	 * util::async_io against synchronous reads for many small and for a few big files,
+	 * the files are read once before measuring so every reader sees a warm page cache
+	 */
+	static inline int _async_io_benchmark_main(std::size_t _small_files = 5000, std::size_t _big_files = 4, std::size_t _big_megabytes = 64)
+	{
+		printf("-----=== utilitylib async_io benchmark ===-----\n");
+
+		const std::filesystem::path directory = std::filesystem::temp_directory_path() / "utilitylib_async_io_benchmark";
+		std::filesystem::create_directories(directory);
+		std::vector<std::filesystem::path> small_paths;
+		std::vector<std::filesystem::path> big_paths;
+		{
+			async_io writer;
+			std::vector<std::pair<std::filesystem::path, bytebuffer>> files;
+			for (std::size_t i = 0; i < _small_files; ++i)
+			{
+				small_paths.emplace_back(directory / ("small_" + std::to_string(i) + ".bin"));
+				files.emplace_back(small_paths.back(), bytebuffer(4096, static_cast<uint8_t>(i)));
+			}
+			for (std::size_t i = 0; i < _big_files; ++i)
+			{
+				big_paths.emplace_back(directory / ("big_" + std::to_string(i) + ".bin"));
+				files.emplace_back(big_paths.back(), bytebuffer(_big_megabytes * 1024ULL * 1024ULL, static_cast<uint8_t>(i)));
+			}
+			double write_ms = _benchmark_ms([&]() {
+				for (std::future<void>& written : writer.write_all(std::move(files))) { written.get(); }
+			});
+			printf("write_all of %zu files   | %9.2f ms\n\n", _small_files + _big_files, write_ms);
+			for (std::future<bytebuffer>& contents : writer.read_all(small_paths)) { contents.get(); }
+			for (std::future<bytebuffer>& contents : writer.read_all(big_paths)) { contents.get(); }
+		}
+
+		_async_io_benchmark_run((std::to_string(_small_files) + " x 4 KB").c_str(), small_paths);
+		_async_io_benchmark_run((std::to_string(_big_files) + " x " + std::to_string(_big_megabytes) + " MB").c_str(), big_paths);
+		printf("\n");
+
+		std::filesystem::remove_all(directory);
+		return 0;
+	}
+
+}
+
+#endif
@@ -0,0 +1,23 @@
+
+#ifndef UTIL_BENCHMARK_UTIL_HPP
+#define UTIL_BENCHMARK_UTIL_HPP
+
+#include <chrono>
+
+namespace util
+{
+
+	/*
+	 * wall time of one call of '_func' in milliseconds, shared by all benchmarks
+	 */
+	template <typename _Func>
+	static inline double _benchmark_ms(_Func&& _func)
+	{
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		_func();
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+}
+
+#endif
@@ -0,0 +1,87 @@
+
+#ifndef UTIL_IO_BENCHMARK_HPP
+#define UTIL_IO_BENCHMARK_HPP
+
+#include "../utilitylib/io.hpp"
+#include "benchmark_util.hpp"
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+
+namespace util
+{
+
+	static inline void _io_benchmark_print(const char* _name, double _ms, std::size_t _bytes)
+	{
+		printf("%-28s | %9.2f ms | %8.1f MB/s\n", _name, _ms, static_cast<double>(_bytes) / (1024.0 * 1024.0) / (_ms / 1000.0));
+	}
+
+	/*
+	 * read and write throughput of util::readfile/overwritefile on a '_megabytes' file against a byte-at-a-time
+	 * stream loop (the previous implementation) and, outside of windows, cat and dd. the file is read once
+	 * before measuring, so every reader sees a warm page cache.
+	 */
+	static inline int _io_benchmark_main(std::size_t _megabytes = 1024)
+	{
+		printf("-----=== utilitylib io benchmark ===-----\n");
+
+		const std::filesystem::path path = std::filesystem::temp_directory_path() / "utilitylib_io_benchmark.bin";
+		const std::size_t bytes = _megabytes * 1024ULL * 1024ULL;
+		std::size_t checksum = 0;
+
+		bytebuffer source(bytes);
+		for (std::size_t i = 0; i < bytes; ++i) { source[i] = static_cast<uint8_t>(i * 2654435761ULL >> 24); }
+
+		printf("%zu MB file at '%s'\n\n", _megabytes, path.string().c_str());
+		_io_benchmark_print("overwritefile", _benchmark_ms([&]() { overwritefile(path, source); }), bytes);
+		_io_benchmark_print("ofstream::put per byte", _benchmark_ms([&]() {
+			std::ofstream file_writer(path, std::ofstream::binary);
+			for (std::size_t i = 0; i < source.size(); ++i) { file_writer.put(static_cast<char>(source[i])); }
+		}), bytes);
+		source = bytebuffer();
+
+		bytebuffer warmup;
+		readfile(path, warmup);
+		warmup = bytebuffer();
+		printf("\n");
+
+#if !defined(_WIN32)
+		std::string quoted = "'" + path.string() + "'";
+		_io_benchmark_print("cat", _benchmark_ms([&]() { checksum += std::system(("cat " + quoted + " > /dev/null").c_str()); }), bytes);
+		_io_benchmark_print("dd bs=1M", _benchmark_ms([&]() { checksum += std::system(("dd if=" + quoted + " of=/dev/null bs=1M 2> /dev/null").c_str()); }), bytes);
+#endif
+		_io_benchmark_print("readfile", _benchmark_ms([&]() {
+			bytebuffer contents;
+			readfile(path, contents);
+			checksum += contents.size();
+		}), bytes);
+
+		bytebuffer buffer(bytes);
+		_io_benchmark_print("readfile into caller buffer", _benchmark_ms([&]() {
+			std::size_t bytes_read = 0;
+			readfile(path, buffer, bytes_read);
+			checksum += bytes_read;
+		}), bytes);
+		buffer = bytebuffer();
+
+		_io_benchmark_print("mapped_file, touch pages", _benchmark_ms([&]() {
+			mapped_file file(path);
+			for (std::size_t i = 0; i < file.size(); i += 4096) { checksum += file.data()[i]; }
+		}), bytes);
+
+		_io_benchmark_print("ifstream::get per byte", _benchmark_ms([&]() {
+			std::ifstream file_reader(path, std::ifstream::binary);
+			bytebuffer contents;
+			for (std::size_t i = 0; i < bytes; ++i) { contents.emplace_back(static_cast<uint8_t>(file_reader.get())); }
+			checksum += contents.size();
+		}), bytes);
+
+		std::filesystem::remove(path);
+		printf("\n(%zu)\n", checksum);
+		return 0;
+	}
+
+}
+
+#endif
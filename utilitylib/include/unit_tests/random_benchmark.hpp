@@ -0,0 +1,125 @@
+
+#ifndef UTIL_RANDOM_BENCHMARK_HPP
+#define UTIL_RANDOM_BENCHMARK_HPP
+
+#include "../utilitylib/random.hpp"
+#include "../utilitylib/thread_pool.hpp"
+#include "benchmark_util.hpp"
+#include <cstdio>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+namespace util
+{
+
+	/*
+	 * the previous util::is_prime, trial division with a floating point sqrt per iteration, as baseline
+	 */
+	static inline bool _random_benchmark_trial_division(uint64_t _num)
+	{
+		for (uint64_t _iter = 2U; _iter <= static_cast<uint64_t>(std::floor(std::sqrt(static_cast<double>(_num)))); ++_iter)
+		{
+			if (!(_num % _iter)) { return false; };
+		}
+		return true;
+	}
+
+	/*
+	 * util::is_prime and util::primes_in_range against trial division, on odd candidates around 10^12
+	 * (where trial division still finishes), on random 64-bit candidates and on enumerating all primes below '_limit'
+	 */
+	static inline void _random_prime_benchmark_run(std::size_t _candidates, uint64_t _limit)
+	{
+		std::size_t found = 0;
+		std::size_t found_trial = 0;
+		printf("\nprimality, %zu odd candidates from 10^12:\n", _candidates);
+		double trial_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _candidates; ++i) { found_trial += _random_benchmark_trial_division(1000000000001ULL + 2 * i); }
+		});
+		double is_prime_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _candidates; ++i) { found += is_prime(1000000000001ULL + 2 * i); }
+		});
+		printf("%-32s | %9.2f ms | %zu primes\n", "trial division (old is_prime)", trial_ms, found_trial);
+		printf("%-32s | %9.2f ms | %zu primes\n", "util::is_prime", is_prime_ms, found);
+
+		std::vector<uint64_t> candidates(_candidates * 100);
+		fill_random(candidates, 0, UINT64_MAX, 42);
+		found = 0;
+		double random_ms = _benchmark_ms([&]() {
+			for (uint64_t candidate : candidates) { found += is_prime(candidate | 1); }
+		});
+		printf("%-32s | %9.2f ms | %zu primes in %zu random 64-bit candidates\n", "util::is_prime", random_ms, found, candidates.size());
+
+		std::vector<uint64_t> primes;
+		printf("\nall primes below %llu:\n", static_cast<unsigned long long>(_limit));
+		printf("%-32s | %9.2f ms\n", "is_prime per number", _benchmark_ms([&]() {
+			for (uint64_t i = 0; i < _limit; ++i) { if (is_prime(i)) { primes.emplace_back(i); } }
+		}));
+		const std::size_t expected = primes.size();
+		for (std::size_t threads = 1; threads <= thread_pool::shared().size(); threads *= 2)
+		{
+			thread_pool pool(threads);
+			double sieve_ms = _benchmark_ms([&]() { primes = primes_in_range(0, _limit - 1, pool); });
+			printf("%2zu threads primes_in_range      | %9.2f ms | %s\n", threads, sieve_ms, primes.size() == expected ? "same count" : "DIFFERENT COUNT");
+		}
+	}
+
+	/*
+	 * '_count' random numbers from per-call std::mt19937 setup (the previous util::randint), util::randint and
+	 * util::fill_random, serial and split over a thread_pool. the parallel fill has to reproduce the serial one.
+	 * then the prime functions, see _random_prime_benchmark_run().
+	 */
+	static inline int _random_benchmark_main(std::size_t _count = 10000000)
+	{
+		printf("-----=== utilitylib random benchmark ===-----\n");
+
+		std::vector<uint64_t> numbers(_count, 0);
+		std::vector<uint64_t> parallel_numbers(_count, 0);
+		std::vector<double> reals(_count, 0.0);
+		uint64_t checksum = 0;
+
+		printf("\n%zu numbers:\n", _count);
+		double mt_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _count / 100; ++i)
+			{
+				std::random_device random_device;
+				std::mt19937 random_number_generator(random_device());
+				numbers[i] = std::uniform_int_distribution<uint64_t>(0, 1000)(random_number_generator);
+			}
+		}) * 100.0;
+		printf("%-32s | %9.2f ms (extrapolated from 1%%)\n", "mt19937 + random_device per call", mt_ms);
+		printf("%-32s | %9.2f ms\n", "util::randint", _benchmark_ms([&]() {
+			for (uint64_t& number : numbers) { number = randint(0, 1000); }
+		}));
+		printf("%-32s | %9.2f ms\n", "xoshiro256::fill", _benchmark_ms([&]() { thread_generator().fill(numbers); }));
+		printf("%-32s | %9.2f ms\n", "fill_random uint64_t", _benchmark_ms([&]() { fill_random(numbers, 0, 1000, 42); }));
+		printf("%-32s | %9.2f ms\n", "fill_random double", _benchmark_ms([&]() { fill_random(std::span<double>(reals), 0.0, 1.0, 42); }));
+		printf("%-32s | %9.2f ms\n", "fill_random_normal double", _benchmark_ms([&]() { fill_random_normal(std::span<double>(reals), 0.0, 1.0, 42); }));
+
+		thread_pool& pool = thread_pool::shared();
+		const std::size_t parts = pool.size() * 4;
+		const std::size_t part_size = (_count + parts - 1) / parts;
+		double parallel_ms = _benchmark_ms([&]() {
+			pool.parallel_for(parts, [&](std::size_t part) {
+				const std::size_t begin = std::min(_count, part * part_size);
+				const std::size_t end = std::min(_count, begin + part_size);
+				fill_random(std::span<uint64_t>(parallel_numbers).subspan(begin, end - begin), 0, 1000, 42, begin);
+			});
+		});
+		printf("%-32s | %9.2f ms | %zu threads | %s\n", "fill_random uint64_t parallel", parallel_ms, pool.size(),
+			parallel_numbers == numbers ? "same as serial" : "DIFFERENT FROM SERIAL");
+
+		for (std::size_t i = 0; i < _count; i += 4096) { checksum += numbers[i] + static_cast<uint64_t>(reals[i]); }
+		printf("(%llu)\n", static_cast<unsigned long long>(checksum));
+
+		_random_prime_benchmark_run(2000, 10000000);
+		printf("\n");
+
+		return 0;
+	}
+
+}
+
+#endif
@@ -0,0 +1,64 @@
+
+#ifndef UTIL_REGEX_BENCHMARK_HPP
+#define UTIL_REGEX_BENCHMARK_HPP
+
+#include "../utilitylib/regex.hpp"
+#include "benchmark_util.hpp"
+#include <string>
+#include <cstdio>
+
+namespace util
+{
+
+	/*
+	 * log-like input of roughly '_bytes' bytes
+	 */
+	static inline std::string _regex_benchmark_input(std::size_t _bytes)
+	{
+		const char* levels[] = { "INFO", "DEBUG", "WARN", "ERROR" };
+		std::string input;
+		input.reserve(_bytes + 128);
+		for (std::size_t i = 0; input.size() < _bytes; ++i)
+		{
+			input.append("2025-01-01 12:00:").append(std::to_string(i % 60)).append(" ").append(levels[i % 4]);
+			input.append(" user").append(std::to_string(i % 997)).append("@example.com id=").append(std::to_string(i * 7919 % 100000));
+			input.append(", value;").append(std::to_string(i % 13)).append("\n");
+		}
+		return input;
+	}
+
+	/*
+	 * get_matches() on std::regex against find_matches() with the cached linear matcher,
+	 * plus the cost of building a pattern over and over
+	 */
+	static inline int _regex_benchmark_main()
+	{
+		printf("-----=== utilitylib regex benchmark ===-----\n");
+
+		const std::string input = _regex_benchmark_input(4ULL * 1024ULL * 1024ULL);
+		printf("input: %zu bytes\n\n", input.size());
+
+		const char* patterns[] = { ",", "[,;]\\s*", "ERROR|WARN", "\\d+", "[a-z]+\\d*@[a-z]+\\.com", "id=(\\d+)" };
+		for (const char* pattern : patterns)
+		{
+			std::size_t std_count = 0;
+			std::size_t view_count = 0;
+			std::regex std_regex(pattern);
+			regex_pattern cached(pattern);
+			double std_ms = _benchmark_ms([&]() { std_count = get_matches(input, std_regex).size(); });
+			double view_ms = _benchmark_ms([&]() { view_count = find_matches(input, cached).size(); });
+			printf("%-24s | std::regex %9.2f ms (%zu) | find_matches %9.2f ms (%zu, %s) | x%.2f\n",
+				pattern, std_ms, std_count, view_ms, view_count, cached.compiled->linear() ? "linear" : "std::regex", std_ms / view_ms);
+		}
+
+		std::size_t repeats = 10000;
+		double construct_ms = _benchmark_ms([&]() { for (std::size_t i = 0; i < repeats; ++i) { std::regex compiled("[a-z]+\\d*@[a-z]+\\.com"); } });
+		double cached_ms = _benchmark_ms([&]() { for (std::size_t i = 0; i < repeats; ++i) { cached_regex("[a-z]+\\d*@[a-z]+\\.com"); } });
+		printf("\n%zu x compile            | std::regex %9.2f ms | cached_regex %9.2f ms\n\n", repeats, construct_ms, cached_ms);
+
+		return 0;
+	}
+
+}
+
+#endif
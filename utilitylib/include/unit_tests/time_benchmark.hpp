@@ -0,0 +1,102 @@
+
+#ifndef UTIL_TIME_BENCHMARK_HPP
+#define UTIL_TIME_BENCHMARK_HPP
+
+#include "../utilitylib/time.hpp"
+#include "benchmark_util.hpp"
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+
+namespace util
+{
+
+	/*
+	 * the previous timestamp rendering, gmtime + std::put_time into a std::stringstream, as baseline
+	 */
+	static inline std::string _time_benchmark_stringstream(std::chrono::system_clock::time_point _time_point)
+	{
+		std::tm _tm = _time::utc(std::chrono::system_clock::to_time_t(_time_point));
+		std::stringstream sstream;
+		sstream << std::put_time(&_tm, timestamp::default_format.c_str());
+		return sstream.str();
+	}
+
+	/*
+	 * iterations execute_for_time manages in '_time_frame' against the previous loop, which formatted a timestamp
+	 * per iteration to check the clock, and the cost of scheduling and cancelling '_timers' connection-style timeouts
+	 */
+	static inline void _time_scheduler_benchmark_run(std::chrono::milliseconds _time_frame, std::size_t _timers)
+	{
+		std::size_t previous_iterations = 0;
+		std::size_t iterations = 0;
+		const std::chrono::system_clock::time_point end = std::chrono::system_clock::now() + _time_frame;
+		while (_time_benchmark_stringstream(std::chrono::system_clock::now()).size() && std::chrono::system_clock::now() < end) { ++previous_iterations; }
+		execute_for_time([&](bool&) { ++iterations; }, _time_frame);
+		printf("\nexecute_for_time, %lld ms:\n", static_cast<long long>(_time_frame.count()));
+		printf("%-36s | %12zu iterations\n", "timestamp per iteration (previous)", previous_iterations);
+		printf("%-36s | %12zu iterations\n", "timer_scheduler token", iterations);
+
+		timer_scheduler scheduler;
+		std::vector<timer_scheduler::task_id> ids(_timers);
+		std::atomic<std::size_t> fired = 0;
+		double schedule_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _timers; ++i) { ids[i] = scheduler.schedule_after(std::chrono::seconds(30) + std::chrono::microseconds(i), [&]() { ++fired; }); }
+		});
+		double cancel_ms = _benchmark_ms([&]() {
+			for (timer_scheduler::task_id id : ids) { scheduler.cancel(id); }
+		});
+		printf("\n%zu timers:\n", _timers);
+		printf("%-36s | %9.2f ms | %6.0f ns per timer\n", "schedule_after", schedule_ms, schedule_ms * 1e6 / static_cast<double>(_timers));
+		printf("%-36s | %9.2f ms | %6.0f ns per timer | (%zu)\n", "cancel", cancel_ms, cancel_ms * 1e6 / static_cast<double>(_timers), fired.load());
+	}
+
+	/*
+	 * cost of one log line timestamp: '_count' times the current time in timestamp::default_format,
+	 * then the timer_scheduler, see _time_scheduler_benchmark_run()
+	 */
+	static inline int _time_benchmark_main(std::size_t _count = 1000000)
+	{
+		printf("-----=== utilitylib time benchmark ===-----\n");
+
+		std::size_t checksum = 0;
+		char buffer[64];
+		timestamp_formatter formatter(timestamp::default_format);
+
+		printf("\n%zu timestamps:\n", _count);
+		double stream_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _count; ++i) { checksum += _time_benchmark_stringstream(std::chrono::system_clock::now()).size(); }
+		});
+		double get_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _count; ++i) { checksum += timestamp::get().size(); }
+		});
+		double get_buffer_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _count; ++i) { checksum += timestamp::get(buffer); }
+		});
+		double formatter_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _count; ++i) { checksum += formatter.format_now(buffer); }
+		});
+		double clock_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _count; ++i) { checksum += static_cast<std::size_t>(std::chrono::system_clock::now().time_since_epoch().count() & 1); }
+		});
+
+		printf("%-36s | %9.2f ms\n", "put_time + stringstream (previous)", stream_ms);
+		printf("%-36s | %9.2f ms | x%.1f\n", "timestamp::get()", get_ms, stream_ms / get_ms);
+		printf("%-36s | %9.2f ms | x%.1f\n", "timestamp::get(buffer)", get_buffer_ms, stream_ms / get_buffer_ms);
+		printf("%-36s | %9.2f ms | x%.1f\n", "timestamp_formatter::format_now", formatter_ms, stream_ms / formatter_ms);
+		printf("%-36s | %9.2f ms | (%zu)\n", "system_clock::now() alone", clock_ms, checksum);
+
+		_time_scheduler_benchmark_run(std::chrono::milliseconds(500), 100000);
+		printf("\n");
+
+		return 0;
+	}
+
+}
+
+#endif
@@ -0,0 +1,217 @@
+
+#ifndef UTIL_TREE_BENCHMARK_HPP
+#define UTIL_TREE_BENCHMARK_HPP
+
+#include "../utilitylib/tree.hpp"
+#include "../utilitylib/pool_tree.hpp"
+#include "../utilitylib/tree_list.hpp"
+#include "../utilitylib/thread_pool.hpp"
+#include "benchmark_util.hpp"
+#include <string>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <utility>
+#include <memory>
+
+namespace util
+{
+
+	/*
+	 * builds '_branches' first-level nodes with '_leaves' children each and
+	 * measures insertion, full traversal, find, filter, deep copy and erasing every leaf
+	 */
+	template <typename _Tree>
+	static inline void _tree_benchmark_run(const char* _name, std::size_t _branches, std::size_t _leaves)
+	{
+		_Tree bench_tree;
+		std::size_t visited = 0;
+
+		double insert_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _branches; ++i)
+			{
+				auto&& branch = bench_tree.emplace_back(i);
+				for (std::size_t j = 0; j < _leaves; ++j) { branch.emplace_back(j); }
+			}
+		});
+		double traverse_ms = _benchmark_ms([&]() {
+			for (typename _Tree::iterator iter = bench_tree.begin(); iter != bench_tree.end(); ++iter) { visited += iter->value(); }
+		});
+		double find_ms = _benchmark_ms([&]() {
+			visited += bench_tree.find(_leaves / 2).size();
+		});
+		double filter_ms = _benchmark_ms([&]() {
+			visited += bench_tree.filter([](const std::size_t& v) { return v % 7 == 0; }).size();
+		});
+		double copy_ms = _benchmark_ms([&]() {
+			_Tree copy(bench_tree);
+			visited += copy.size();
+		});
+		double erase_ms = _benchmark_ms([&]() {
+			for (typename _Tree::iterator iter = bench_tree.begin(); iter != bench_tree.end();)
+			{
+				if (iter->has_children()) { ++iter; }
+				else { iter = bench_tree.erase(iter); }
+			}
+		});
+
+		printf("%-16s | insert %9.2f ms | traverse %9.2f ms | find %9.2f ms | filter %9.2f ms | copy %9.2f ms | erase leaves %9.2f ms | (%zu)\n",
+			_name, insert_ms, traverse_ms, find_ms, filter_ms, copy_ms, erase_ms, visited);
+	}
+
+	/*
+	 * util::tree_list against util::tree and a flat pre-order vector of (value, depth) as baseline,
+	 * measures insertion, full traversal and erasing every leaf
+	 */
+	static inline void _tree_list_benchmark_run(std::size_t _branches, std::size_t _leaves)
+	{
+		std::size_t visited = 0;
+
+		tree_list<std::size_t> bench_list;
+		double list_insert_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _branches; ++i)
+			{
+				tree_list<std::size_t>::tree_node& branch = bench_list.emplace_back(i);
+				for (std::size_t j = 0; j < _leaves; ++j) { bench_list.emplace_back_child(branch, j); }
+			}
+		});
+		double list_traverse_ms = _benchmark_ms([&]() {
+			for (tree_list<std::size_t>::iterator iter = bench_list.begin(); iter != bench_list.end(); ++iter) { visited += iter->get(); }
+		});
+		double list_erase_ms = _benchmark_ms([&]() {
+			for (tree_list<std::size_t>::iterator iter = bench_list.begin(); iter != bench_list.end();)
+			{
+				if (iter->child_num()) { ++iter; }
+				else { iter = bench_list.erase(iter); }
+			}
+		});
+
+		tree<std::size_t> bench_tree;
+		double tree_insert_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _branches; ++i)
+			{
+				tree<std::size_t>::node& branch = bench_tree.emplace_back(i);
+				for (std::size_t j = 0; j < _leaves; ++j) { branch.emplace_back(j); }
+			}
+		});
+		double tree_traverse_ms = _benchmark_ms([&]() {
+			for (tree<std::size_t>::iterator iter = bench_tree.begin(); iter != bench_tree.end(); ++iter) { visited += iter->value(); }
+		});
+		double tree_erase_ms = _benchmark_ms([&]() {
+			for (tree<std::size_t>::iterator iter = bench_tree.begin(); iter != bench_tree.end();)
+			{
+				if (iter->has_children()) { ++iter; }
+				else { iter = bench_tree.erase(iter); }
+			}
+		});
+
+		std::vector<std::pair<std::size_t, std::size_t>> bench_flat;
+		double flat_insert_ms = _benchmark_ms([&]() {
+			for (std::size_t i = 0; i < _branches; ++i)
+			{
+				bench_flat.emplace_back(i, 1ULL);
+				for (std::size_t j = 0; j < _leaves; ++j) { bench_flat.emplace_back(j, 2ULL); }
+			}
+		});
+		double flat_traverse_ms = _benchmark_ms([&]() {
+			for (const std::pair<std::size_t, std::size_t>& entry : bench_flat) { visited += entry.first; }
+		});
+		double flat_erase_ms = _benchmark_ms([&]() {
+			std::erase_if(bench_flat, [](const std::pair<std::size_t, std::size_t>& entry) { return entry.second == 2ULL; });
+		});
+
+		printf("%-16s | insert %9.2f ms | traverse %9.2f ms | erase leaves %9.2f ms\n", "util::tree_list", list_insert_ms, list_traverse_ms, list_erase_ms);
+		printf("%-16s | insert %9.2f ms | traverse %9.2f ms | erase leaves %9.2f ms\n", "util::tree", tree_insert_ms, tree_traverse_ms, tree_erase_ms);
+		printf("%-16s | insert %9.2f ms | traverse %9.2f ms | erase leaves %9.2f ms | (%zu)\n", "flat vector", flat_insert_ms, flat_traverse_ms, flat_erase_ms, visited);
+	}
+
+	/*
+	 * filter_parallel() scaling over thread counts with a deliberately expensive predicate
+	 */
+	static inline void _tree_parallel_benchmark_run(std::size_t _branches, std::size_t _leaves)
+	{
+		tree<std::size_t> bench_tree;
+		tree_list<std::size_t> bench_list;
+		for (std::size_t i = 0; i < _branches; ++i)
+		{
+			tree<std::size_t>::node& branch = bench_tree.emplace_back(i);
+			tree_list<std::size_t>::tree_node& list_branch = bench_list.emplace_back(i);
+			for (std::size_t j = 0; j < _leaves; ++j) { branch.emplace_back(j); bench_list.emplace_back_child(list_branch, j); }
+		}
+		auto expensive = [](std::size_t v) {
+			for (int k = 0; k < 200; ++k) { v = v * 6364136223846793005ULL + 1442695040888963407ULL; }
+			return (v >> 60) == 0;
+		};
+
+		printf("\nfilter_parallel, %zu nodes:\n", bench_tree.size());
+		double serial_ms = _benchmark_ms([&]() { bench_tree.filter([&](const std::size_t& v) { return expensive(v); }); });
+		printf("%-24s | %9.2f ms\n", "util::tree filter", serial_ms);
+		for (std::size_t threads = 1; threads <= std::thread::hardware_concurrency(); threads *= 2)
+		{
+			thread_pool pool(threads);
+			double tree_ms = _benchmark_ms([&]() { bench_tree.filter_parallel([&](const std::size_t& v) { return expensive(v); }, 4096, pool); });
+			double list_ms = _benchmark_ms([&]() { bench_list.filter_parallel([&](const tree_list<std::size_t>::tree_node& n) { return expensive(n.value()); }, 4096, pool); });
+			printf("%2zu threads               | util::tree %9.2f ms (x%.2f) | util::tree_list %9.2f ms\n", threads, tree_ms, serial_ms / tree_ms, list_ms);
+		}
+	}
+
+	/*
+	 * one chain of '_levels' nodes, every insertion followed by size(), then subtree_size() and height() of the
+	 * first node, a deep copy and the teardown. all steps have to stay linear in '_levels'
+	 */
+	static inline void _tree_chain_benchmark_run(std::size_t _levels)
+	{
+		std::size_t checksum = 0;
+		std::unique_ptr<tree<std::size_t>> bench_tree = std::make_unique<tree<std::size_t>>();
+		double insert_ms = _benchmark_ms([&]() {
+			tree<std::size_t>::node* last = &bench_tree->emplace_back(0);
+			for (std::size_t i = 1; i < _levels; ++i)
+			{
+				last = &last->emplace_back(i);
+				checksum += bench_tree->size();
+			}
+		});
+		double stats_ms = _benchmark_ms([&]() {
+			checksum += bench_tree->begin()->subtree_size() + bench_tree->height();
+		});
+		std::unique_ptr<tree<std::size_t>> copy;
+		double copy_ms = _benchmark_ms([&]() { copy = std::make_unique<tree<std::size_t>>(*bench_tree); });
+		double destroy_ms = _benchmark_ms([&]() { bench_tree.reset(); copy.reset(); });
+
+		printf("%-16s | %8zu levels | insert + size() %9.2f ms | subtree_size() + height() %9.2f ms | copy %9.2f ms | destroy both %9.2f ms | (%zu)\n",
+			"util::tree", _levels, insert_ms, stats_ms, copy_ms, destroy_ms, checksum);
+	}
+
+	/*
+	 * compare util::tree against util::pool_tree and util::tree_list, build in release for meaningful numbers
+	 */
+	static inline int _tree_benchmark_main()
+	{
+		printf("-----=== utilitylib tree benchmark ===-----\n");
+
+		const std::size_t shapes[][2] = { { 1000, 100 }, { 100, 1000 }, { 1, 100000 } };
+		for (const auto& shape : shapes)
+		{
+			printf("\n%zu branches x %zu leaves:\n", shape[0], shape[1]);
+			_tree_benchmark_run<tree<std::size_t>>("util::tree", shape[0], shape[1]);
+			_tree_benchmark_run<pool_tree<std::size_t>>("util::pool_tree", shape[0], shape[1]);
+		}
+		for (const auto& shape : shapes)
+		{
+			printf("\ntree_list, %zu branches x %zu leaves:\n", shape[0], shape[1]);
+			_tree_list_benchmark_run(shape[0], shape[1]);
+		}
+		printf("\nchains:\n");
+		for (std::size_t levels : { 100000ULL, 1000000ULL })
+		{
+			_tree_chain_benchmark_run(levels);
+		}
+		_tree_parallel_benchmark_run(1000, 1000);
+		printf("\n");
+
+		return 0;
+	}
+
+}
+
+#endif
@@ -20,14 +20,14 @@ namespace util
 		tree<std::string> example_tree;
 
 		// customer 1
-		tree<std::string>::iterator customer_1 = example_tree.emplace_back("customer");
-		tree<std::string>::iterator name_1 = customer_1->emplace_back("name");
+		tree<std::string>::node& customer_1 = example_tree.emplace_back("customer");
+		tree<std::string>::node& name_1 = customer_1.emplace_back("name");
 		// customer 2
-		tree<std::string>::iterator customer_2 = example_tree.emplace_back("customer");
-		tree<std::string>::iterator name_2 = customer_2->emplace_back("name");
+		tree<std::string>::node& customer_2 = example_tree.emplace_back("customer");
+		tree<std::string>::node& name_2 = customer_2.emplace_back("name");
 		// customer 3
-		tree<std::string>::iterator customer_3 = example_tree.emplace_back("customer");
-		tree<std::string>::iterator name_3 = customer_3->emplace_back("name");
+		tree<std::string>::node& customer_3 = example_tree.emplace_back("customer");
+		tree<std::string>::node& name_3 = customer_3.emplace_back("name");
 
 
 
@@ -40,7 +40,7 @@ namespace util
 		printf("\n");
 
 		printf("retreiving all 'name' nodes and adding a name\n\n");
-		std::vector<tree<std::string>::iterator> names = example_tree.find("name");
+		std::vector<tree<std::string>::iterator> names = example_tree.find_iterators("name");
 		for (auto& d : names) { d->emplace_back("john"); }
 
 		printf("example tree 1 : second iteration\n");
@@ -51,6 +51,35 @@ namespace util
 		}
 		printf("\n");
 
+		printf("example tree 1 : reverse, post-order and breadth-first iteration\n");
+		for (tree<std::string>::reverse_iterator iter = example_tree.rbegin(); iter != example_tree.rend(); ++iter) { printf("%s ", iter->value().c_str()); }
+		printf("\n");
+		for (tree<std::string>::post_order_iterator iter = example_tree.post_order_begin(); iter != example_tree.post_order_end(); ++iter) { printf("%s ", iter->value().c_str()); }
+		printf("\n");
+		for (tree<std::string>::breadth_first_iterator iter = example_tree.breadth_first_begin(); iter != example_tree.breadth_first_end(); ++iter) { printf("%s ", iter->value().c_str()); }
+		printf("\n");
+		printf("level 2: ");
+		for (tree<std::string>::breadth_first_iterator iter = example_tree.level_begin(2); iter != example_tree.level_end(); ++iter) { printf("%s ", iter->value().c_str()); }
+		printf("\n\n");
+
+		printf("example tree 2: erasing a node with children returns the node after its subtree\n");
+		tree<std::string> erase_tree;
+		tree<std::string>::node& first = erase_tree.emplace_back("1");
+		first.emplace_back("11");
+		first.emplace_back("12");
+		erase_tree.emplace_back("2");
+		tree<std::string>::iterator after = erase_tree.erase(erase_tree.begin());
+		if (after == erase_tree.end() || after->value() != "2" || erase_tree.size() != 1ULL) {
+			printf("erase failed\n");
+			return 1;
+		}
+		after = erase_tree.erase(after);
+		if (after != erase_tree.end() || erase_tree.size() != 0ULL) {
+			printf("erase failed\n");
+			return 1;
+		}
+		printf("erase ok\n\n");
+
 		return 0;
 	}
 
@@ -9,5 +9,6 @@
 #include "utilitylib/random.hpp"
 #include "utilitylib/regex.hpp"
 #include "utilitylib/stringmanip.hpp"
+#include "utilitylib/thread_pool.hpp"
 #include "utilitylib/time.hpp"
 ////////////////////////////////////////
\ No newline at end of file
@@ -0,0 +1,666 @@
+////////////////////////////////////////
+/// general utility header-only-library
+/// for convenience methods/types in C++
+/// 2025 Julian Benzel
+////////////////////////////////////////
+/// asynchronous file i/o
+////////////////////////////////////////
+#ifndef UTILITYLIB_ASYNC_IO_HPP
+#define UTILITYLIB_ASYNC_IO_HPP
+////////////////////////////////////////
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "io.hpp"
+#include "thread_pool.hpp"
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define UTILITYLIB_ASYNC_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+////////////////////////////////////////
+namespace util
+{
+	namespace _async_io
+	{
+		/*
+		* one file request, owned by the async_io from submission until its completion callback ran
+		*/
+		struct operation
+		{
+			std::filesystem::path path;
+			bool writing = false;
+			bool whole_file = false; // read the complete file into 'storage'
+			uint8_t* data = nullptr;
+			size_t size = 0;
+			size_t done = 0;
+			uint64_t offset = 0;
+			bytebuffer storage;      // file contents for whole-file reads and writes
+			int fd = -1;
+			std::function<void(operation&, std::exception_ptr)> complete;
+		};
+
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+		/*
+		* minimal io_uring on the raw system calls: a submission and a completion ring shared with the kernel
+		*/
+		class ring
+		{
+		public:
+			ring() = default;
+			ring(const ring&) = delete;
+			ring& operator=(const ring&) = delete;
+
+			~ring()
+			{
+				close();
+			}
+
+			/*
+			* @returns false if io_uring is not available (old kernel, seccomp filter, ...)
+			*/
+			bool open(unsigned entries)
+			{
+				io_uring_params params;
+				std::memset(&params, 0, sizeof(params));
+				int fd = static_cast<int>(::syscall(__NR_io_uring_setup, std::max(entries, 1u), &params));
+				if (fd < 0)
+				{
+					return false;
+				}
+				ring_fd = fd;
+				// IORING_OP_READ/WRITE arrived together with this feature (5.6)
+				if (!(params.features & IORING_FEAT_RW_CUR_POS))
+				{
+					close();
+					return false;
+				}
+				sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+				cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+				bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+				if (single_mmap)
+				{
+					sq_map_size = cq_map_size = std::max(sq_map_size, cq_map_size);
+				}
+				sq_map = ::mmap(nullptr, sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+				cq_map = single_mmap ? sq_map : ::mmap(nullptr, cq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+				sqes_map_size = params.sq_entries * sizeof(io_uring_sqe);
+				void* sqes_map = ::mmap(nullptr, sqes_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+				if (sq_map == MAP_FAILED || cq_map == MAP_FAILED || sqes_map == MAP_FAILED)
+				{
+					if (sqes_map != MAP_FAILED) { ::munmap(sqes_map, sqes_map_size); }
+					close();
+					return false;
+				}
+				uint8_t* sq = static_cast<uint8_t*>(sq_map);
+				uint8_t* cq = static_cast<uint8_t*>(cq_map);
+				sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+				sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+				sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+				cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+				cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+				cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+				cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+				sqes = static_cast<io_uring_sqe*>(sqes_map);
+				sq_entries = params.sq_entries;
+				cq_entries = params.cq_entries;
+				return true;
+			}
+
+			void close()
+			{
+				if (sqes) { ::munmap(sqes, sqes_map_size); }
+				if (cq_map && cq_map != MAP_FAILED && cq_map != sq_map) { ::munmap(cq_map, cq_map_size); }
+				if (sq_map && sq_map != MAP_FAILED) { ::munmap(sq_map, sq_map_size); }
+				if (ring_fd >= 0) { ::close(ring_fd); }
+				sqes = nullptr;
+				sq_map = cq_map = nullptr;
+				ring_fd = -1;
+			}
+
+			unsigned completion_capacity() const { return cq_entries; }
+			bool full() const { return pending >= sq_entries; }
+
+			// queues a request, the caller makes sure that there is room (full()) and serializes submitters
+			void queue(uint8_t opcode, int fd, void* addr, uint32_t length, uint64_t offset, uint64_t user_data)
+			{
+				unsigned tail = *sq_tail;
+				unsigned index = tail & sq_mask;
+				io_uring_sqe& sqe = sqes[index];
+				std::memset(&sqe, 0, sizeof(sqe));
+				sqe.opcode = opcode;
+				sqe.fd = fd;
+				sqe.addr = reinterpret_cast<uint64_t>(addr);
+				sqe.len = length;
+				sqe.off = offset;
+				sqe.user_data = user_data;
+				sq_array[index] = index;
+				std::atomic_ref<unsigned>(*sq_tail).store(tail + 1, std::memory_order_release);
+				pending++;
+			}
+
+			// hands every queued request to the kernel in one system call
+			void submit()
+			{
+				while (pending)
+				{
+					int res = static_cast<int>(::syscall(__NR_io_uring_enter, ring_fd, pending, 0, 0, nullptr, 0));
+					if (res < 0)
+					{
+						if (errno == EINTR || errno == EAGAIN) { continue; }
+						throw std::runtime_error("io_uring submission failed");
+					}
+					pending -= static_cast<unsigned>(res);
+				}
+			}
+
+			// blocks until at least one completion is available
+			void wait()
+			{
+				::syscall(__NR_io_uring_enter, ring_fd, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+			}
+
+			// calls 'func(user_data, result)' for every available completion, single consumer
+			template <typename Func>
+			size_t reap(Func&& func)
+			{
+				unsigned head = *cq_head;
+				unsigned tail = std::atomic_ref<unsigned>(*cq_tail).load(std::memory_order_acquire);
+				size_t count = 0;
+				for (; head != tail; head++, count++)
+				{
+					const io_uring_cqe& cqe = cqes[head & cq_mask];
+					uint64_t user_data = cqe.user_data;
+					int result = cqe.res;
+					std::atomic_ref<unsigned>(*cq_head).store(head + 1, std::memory_order_release);
+					func(user_data, result);
+				}
+				return count;
+			}
+
+		private:
+			int ring_fd = -1;
+			void* sq_map = nullptr;
+			void* cq_map = nullptr;
+			size_t sq_map_size = 0;
+			size_t cq_map_size = 0;
+			size_t sqes_map_size = 0;
+			unsigned* sq_tail = nullptr;
+			unsigned* sq_array = nullptr;
+			unsigned sq_mask = 0;
+			unsigned* cq_head = nullptr;
+			unsigned* cq_tail = nullptr;
+			unsigned cq_mask = 0;
+			io_uring_cqe* cqes = nullptr;
+			io_uring_sqe* sqes = nullptr;
+			unsigned sq_entries = 0;
+			unsigned cq_entries = 0;
+			unsigned pending = 0; // queued but not yet submitted
+		};
+#endif
+	}
+
+	/*
+	* asynchronous file reads and writes
+	*
+	* on linux the requests go to the kernel through an io_uring. every call queues its requests and enters
+	* the kernel once for all of them, a background thread reaps the completions. where io_uring is not
+	* available (other platforms, old kernels, seccomp filters) or not wanted, every request runs as blocking
+	* pread/pwrite calls on a thread_pool instead.
+	* results arrive through futures or completion callbacks. callbacks run on the completion thread or on a
+	* pool worker, so they should be short and must not throw. the destructor waits for all requests.
+	*/
+	class async_io
+	{
+	public:
+		using read_callback = std::function<void(bytebuffer contents, std::exception_ptr error)>;
+		using write_callback = std::function<void(std::exception_ptr error)>;
+
+		/*
+		* @param queue_depth - size of the submission queue, requests beyond it are submitted in several rounds
+		* @param allow_io_uring - false always uses the thread_pool
+		* @param pool - pool for the fallback and for nothing else
+		*/
+		explicit async_io(unsigned queue_depth = 256, bool allow_io_uring = true, thread_pool& pool = thread_pool::shared())
+			: pool(pool)
+		{
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+			if (allow_io_uring && ring.open(queue_depth))
+			{
+				uring = true;
+				inflight_limit = ring.completion_capacity();
+				reaper = std::thread([this]() { reap_loop(); });
+			}
+#else
+			(void)queue_depth;
+			(void)allow_io_uring;
+#endif
+		}
+
+		async_io(const async_io&) = delete;
+		async_io& operator=(const async_io&) = delete;
+
+		~async_io()
+		{
+			{
+				std::unique_lock<std::mutex> lock(state_mutex);
+				idle.wait(lock, [this]() { return !inflight; });
+			}
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+			if (uring)
+			{
+				{
+					std::lock_guard<std::mutex> lock(submit_mutex);
+					ring.queue(IORING_OP_NOP, -1, nullptr, 0, 0, 0); // user_data 0 stops the reaper
+					ring.submit();
+				}
+				reaper.join();
+			}
+#endif
+		}
+
+		/*
+		* @returns if requests go through io_uring
+		*/
+		bool uses_io_uring() const
+		{
+			return uring;
+		}
+
+		/*
+		* reads the whole file at 'path'
+		*/
+		void read(const std::filesystem::path& path, read_callback callback)
+		{
+			std::vector<std::unique_ptr<_async_io::operation>> batch;
+			batch.emplace_back(make_read(path, std::move(callback)));
+			start(batch);
+		}
+
+		std::future<bytebuffer> read(const std::filesystem::path& path)
+		{
+			std::future<bytebuffer> res;
+			read(path, promise_callback(res));
+			return res;
+		}
+
+		/*
+		* reads every file of 'paths', all of them are submitted as one batch
+		*/
+		std::vector<std::future<bytebuffer>> read_all(const std::vector<std::filesystem::path>& paths)
+		{
+			std::vector<std::future<bytebuffer>> res(paths.size());
+			std::vector<std::unique_ptr<_async_io::operation>> batch;
+			batch.reserve(paths.size());
+			for (size_t i = 0; i < paths.size(); i++)
+			{
+				batch.emplace_back(make_read(paths[i], promise_callback(res[i])));
+			}
+			start(batch);
+			return res;
+		}
+
+		/*
+		* reads up to 'buffer.size()' bytes at 'offset' into a caller-provided buffer, which has to stay valid until completion
+		* @returns future for the number of bytes read
+		*/
+		std::future<size_t> read_into(const std::filesystem::path& path, std::span<uint8_t> buffer, uint64_t offset = 0)
+		{
+			std::shared_ptr<std::promise<size_t>> promise = std::make_shared<std::promise<size_t>>();
+			std::future<size_t> res = promise->get_future();
+			std::unique_ptr<_async_io::operation> op = std::make_unique<_async_io::operation>();
+			op->path = path;
+			op->data = buffer.data();
+			op->size = buffer.size();
+			op->offset = offset;
+			op->complete = [promise](_async_io::operation& done_op, std::exception_ptr error)
+			{
+				if (error) { promise->set_exception(error); }
+				else { promise->set_value(done_op.done); }
+			};
+			std::vector<std::unique_ptr<_async_io::operation>> batch;
+			batch.emplace_back(std::move(op));
+			start(batch);
+			return res;
+		}
+
+		/*
+		* replaces the file at 'path' with 'contents', which the request keeps until completion
+		*/
+		void write(const std::filesystem::path& path, bytebuffer contents, write_callback callback)
+		{
+			std::vector<std::unique_ptr<_async_io::operation>> batch;
+			batch.emplace_back(make_write(path, std::move(contents), std::move(callback)));
+			start(batch);
+		}
+
+		std::future<void> write(const std::filesystem::path& path, bytebuffer contents)
+		{
+			std::future<void> res;
+			write(path, std::move(contents), promise_callback(res));
+			return res;
+		}
+
+		/*
+		* writes every (path, contents) pair, all of them are submitted as one batch
+		*/
+		std::vector<std::future<void>> write_all(std::vector<std::pair<std::filesystem::path, bytebuffer>> files)
+		{
+			std::vector<std::future<void>> res(files.size());
+			std::vector<std::unique_ptr<_async_io::operation>> batch;
+			batch.reserve(files.size());
+			for (size_t i = 0; i < files.size(); i++)
+			{
+				batch.emplace_back(make_write(files[i].first, std::move(files[i].second), promise_callback(res[i])));
+			}
+			start(batch);
+			return res;
+		}
+
+	private:
+		using operation = _async_io::operation;
+
+		thread_pool& pool;
+		bool uring = false;
+		std::mutex state_mutex;
+		std::condition_variable idle;
+		size_t inflight = 0;
+		size_t inflight_limit = SIZE_MAX; // io_uring: the completion queue must never overflow
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+		_async_io::ring ring;
+		std::mutex submit_mutex;
+		std::thread reaper;
+#endif
+
+		static read_callback promise_callback(std::future<bytebuffer>& future)
+		{
+			std::shared_ptr<std::promise<bytebuffer>> promise = std::make_shared<std::promise<bytebuffer>>();
+			future = promise->get_future();
+			return [promise](bytebuffer contents, std::exception_ptr error)
+			{
+				if (error) { promise->set_exception(error); }
+				else { promise->set_value(std::move(contents)); }
+			};
+		}
+
+		static write_callback promise_callback(std::future<void>& future)
+		{
+			std::shared_ptr<std::promise<void>> promise = std::make_shared<std::promise<void>>();
+			future = promise->get_future();
+			return [promise](std::exception_ptr error)
+			{
+				if (error) { promise->set_exception(error); }
+				else { promise->set_value(); }
+			};
+		}
+
+		static std::unique_ptr<operation> make_read(const std::filesystem::path& path, read_callback callback)
+		{
+			std::unique_ptr<operation> op = std::make_unique<operation>();
+			op->path = path;
+			op->whole_file = true;
+			op->complete = [callback = std::move(callback)](operation& done_op, std::exception_ptr error)
+			{
+				callback(error ? bytebuffer() : std::move(done_op.storage), error);
+			};
+			return op;
+		}
+
+		static std::unique_ptr<operation> make_write(const std::filesystem::path& path, bytebuffer contents, write_callback callback)
+		{
+			std::unique_ptr<operation> op = std::make_unique<operation>();
+			op->path = path;
+			op->writing = true;
+			op->storage = std::move(contents);
+			op->data = op->storage.data();
+			op->size = op->storage.size();
+			op->complete = [callback = std::move(callback)](operation&, std::exception_ptr error) { callback(error); };
+			return op;
+		}
+
+#if !defined(_WIN32)
+		// opens the file and sizes whole-file reads
+		static void open_file(operation& op)
+		{
+			op.fd = ::open(op.path.c_str(), op.writing ? O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC : O_RDONLY | O_CLOEXEC, 0644);
+			if (op.fd < 0)
+			{
+				throw std::runtime_error("could not open file '" + op.path.string() + "'");
+			}
+			if (op.whole_file)
+			{
+				struct stat file_stat;
+				if (::fstat(op.fd, &file_stat) != 0)
+				{
+					throw std::runtime_error("could not determine size of file '" + op.path.string() + "'");
+				}
+				op.storage.resize(static_cast<size_t>(file_stat.st_size));
+				op.data = op.storage.data();
+				op.size = op.storage.size();
+			}
+		}
+#endif
+
+		// the thread_pool fallback, the whole request as blocking calls
+		static void run_blocking(operation& op)
+		{
+#if defined(_WIN32)
+			if (op.writing)
+			{
+				std::ofstream file_writer(op.path, std::ofstream::binary | std::ofstream::trunc);
+				file_writer.write(reinterpret_cast<const char*>(op.data), static_cast<std::streamsize>(op.size));
+				file_writer.close();
+				if (!file_writer) { throw std::runtime_error("could not write file '" + op.path.string() + "'"); }
+				op.done = op.size;
+				return;
+			}
+			std::ifstream file_reader(op.path, std::ifstream::binary);
+			if (!file_reader.is_open()) { throw std::runtime_error("could not open file '" + op.path.string() + "'"); }
+			if (op.whole_file)
+			{
+				op.storage.resize(static_cast<size_t>(std::filesystem::file_size(op.path)));
+				op.data = op.storage.data();
+				op.size = op.storage.size();
+			}
+			file_reader.seekg(static_cast<std::streamoff>(op.offset));
+			file_reader.read(reinterpret_cast<char*>(op.data), static_cast<std::streamsize>(op.size));
+			op.done = static_cast<size_t>(file_reader.gcount());
+			if (file_reader.bad()) { throw std::runtime_error("could not read file '" + op.path.string() + "'"); }
+#else
+			open_file(op);
+			while (op.done < op.size)
+			{
+				ssize_t res = op.writing
+					? ::pwrite(op.fd, op.data + op.done, op.size - op.done, static_cast<off_t>(op.offset + op.done))
+					: ::pread(op.fd, op.data + op.done, op.size - op.done, static_cast<off_t>(op.offset + op.done));
+				if (res < 0 && errno == EINTR)
+				{
+					continue;
+				}
+				if (res < 0 || (res == 0 && op.writing))
+				{
+					throw std::runtime_error(std::string("could not ") + (op.writing ? "write" : "read") + " file '" + op.path.string() + "'");
+				}
+				if (res == 0)
+				{
+					break; // end of file
+				}
+				op.done += static_cast<size_t>(res);
+			}
+#endif
+		}
+
+		// counts a request as in flight, io_uring requests wait for room in the completion queue
+		void reserve()
+		{
+			std::unique_lock<std::mutex> lock(state_mutex);
+			if (inflight >= inflight_limit)
+			{
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+				// requests queued by this thread have to reach the kernel before waiting for their completions
+				lock.unlock();
+				{
+					std::lock_guard<std::mutex> submit_lock(submit_mutex);
+					ring.submit();
+				}
+				lock.lock();
+#endif
+				idle.wait(lock, [this]() { return inflight < inflight_limit; });
+			}
+			inflight++;
+		}
+
+		void finish(std::unique_ptr<operation> op, std::exception_ptr error)
+		{
+#if !defined(_WIN32)
+			if (op->fd >= 0)
+			{
+				::close(op->fd);
+				op->fd = -1;
+			}
+#endif
+			if (op->whole_file && !error)
+			{
+				op->storage.resize(op->done); // the file may have shrunk in the meantime
+			}
+			try
+			{
+				op->complete(*op, error);
+			}
+			catch (...)
+			{
+				// callbacks must not throw, there is nobody to report it to
+			}
+			op.reset();
+			// notified under the lock, the destructor may destroy 'idle' as soon as it can see the count drop
+			std::lock_guard<std::mutex> lock(state_mutex);
+			inflight--;
+			idle.notify_all();
+		}
+
+		void start(std::vector<std::unique_ptr<operation>>& batch)
+		{
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+			if (uring)
+			{
+				for (std::unique_ptr<operation>& op : batch)
+				{
+					reserve();
+					try
+					{
+						open_file(*op);
+					}
+					catch (...)
+					{
+						finish(std::move(op), std::current_exception());
+						continue;
+					}
+					if (!op->size)
+					{
+						finish(std::move(op), nullptr);
+						continue;
+					}
+					std::lock_guard<std::mutex> lock(submit_mutex);
+					queue_transfer(op.release());
+				}
+				std::lock_guard<std::mutex> lock(submit_mutex);
+				ring.submit();
+				return;
+			}
+#endif
+			for (std::unique_ptr<operation>& op : batch)
+			{
+				reserve();
+				pool.submit([this, raw = op.release()]()
+				{
+					std::unique_ptr<operation> owned(raw);
+					std::exception_ptr error;
+					try
+					{
+						run_blocking(*owned);
+					}
+					catch (...)
+					{
+						error = std::current_exception();
+					}
+					finish(std::move(owned), error);
+				});
+			}
+		}
+
+#if defined(UTILITYLIB_ASYNC_IO_URING)
+		// queues the rest of 'op', submit_mutex has to be held
+		void queue_transfer(operation* op)
+		{
+			if (ring.full())
+			{
+				ring.submit();
+			}
+			uint32_t length = static_cast<uint32_t>(std::min<size_t>(op->size - op->done, 1u << 30));
+			ring.queue(op->writing ? IORING_OP_WRITE : IORING_OP_READ, op->fd, op->data + op->done, length, op->offset + op->done, reinterpret_cast<uint64_t>(op));
+		}
+
+		void reap_loop()
+		{
+			bool stopping = false;
+			while (!stopping)
+			{
+				size_t reaped = ring.reap([&](uint64_t user_data, int result)
+				{
+					if (!user_data)
+					{
+						stopping = true;
+						return;
+					}
+					operation* op = reinterpret_cast<operation*>(user_data);
+					if (result == -EINTR || result == -EAGAIN)
+					{
+						std::lock_guard<std::mutex> lock(submit_mutex);
+						queue_transfer(op);
+						ring.submit();
+						return;
+					}
+					if (result < 0 || (result == 0 && op->writing && op->done < op->size))
+					{
+						std::string what = std::string("could not ") + (op->writing ? "write" : "read") + " file '" + op->path.string() + "'";
+						finish(std::unique_ptr<operation>(op), std::make_exception_ptr(std::runtime_error(what)));
+						return;
+					}
+					op->done += static_cast<size_t>(result);
+					if (result > 0 && op->done < op->size) // short transfer, continue where it stopped
+					{
+						std::lock_guard<std::mutex> lock(submit_mutex);
+						queue_transfer(op);
+						ring.submit();
+						return;
+					}
+					finish(std::unique_ptr<operation>(op), nullptr);
+				});
+				if (!reaped && !stopping)
+				{
+					ring.wait();
+				}
+			}
+		}
+#endif
+	};
+}
+////////////////////////////////////////
+#endif
+////////////////////////////////////////
@@ -10,32 +10,87 @@
 ////////////////////////////////////////
 #include <vector>
 #include <string>
+#include <string_view>
+#include <span>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <stdexcept>
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 ////////////////////////////////////////
 namespace util
 {
 	typedef std::vector<uint8_t> bytebuffer;
 
+	/*
+	* non-owning views between bytes and characters, valid as long as the viewed storage
+	*/
+	static inline std::string_view to_string_view(std::span<const std::byte> bytes)
+	{
+		return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	}
+
+	static inline std::string_view to_string_view(std::span<const uint8_t> bytes)
+	{
+		return std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+	}
+
+	static inline std::span<const std::byte> to_byte_view(std::string_view str)
+	{
+		return std::span<const std::byte>(reinterpret_cast<const std::byte*>(str.data()), str.size());
+	}
+
+	static inline std::span<const uint8_t> to_buffer_view(std::string_view str)
+	{
+		return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+	}
+
+	/*
+	* owning copies, one allocation and one bulk copy each
+	*/
 	static inline std::string to_string(const bytebuffer& buffer)
 	{
-		std::string res;
-		for (size_t i = 0; i < buffer.size(); i++)
-		{
-			res.append(1, buffer[i]);
-		}
-		return res;
+		return std::string(to_string_view(buffer));
 	}
 
-	static inline bytebuffer to_buffer(const std::string& str)
+	static inline std::string to_string(std::span<const std::byte> bytes)
 	{
-		bytebuffer res;
-		for (size_t i = 0; i < str.size(); i++)
-		{
-			res.emplace_back(static_cast<uint8_t>(str[i]));
-		}
-		return res;
+		return std::string(to_string_view(bytes));
+	}
+
+	static inline bytebuffer to_buffer(std::string_view str)
+	{
+		std::span<const uint8_t> bytes = to_buffer_view(str);
+		return bytebuffer(bytes.begin(), bytes.end());
+	}
+
+	/*
+	* copies into existing storage, which keeps its capacity. meant for buffers that are refilled in a loop,
+	* std::string and std::vector cannot hand over their allocations to each other.
+	*/
+	static inline void to_string(std::span<const uint8_t> bytes, std::string& out)
+	{
+		out.assign(to_string_view(bytes));
+	}
+
+	static inline void to_buffer(std::string_view str, bytebuffer& out)
+	{
+		std::span<const uint8_t> bytes = to_buffer_view(str);
+		out.assign(bytes.begin(), bytes.end());
 	}
 
 	template <typename Type>
@@ -57,21 +112,31 @@ namespace util
 		return res;
 	}
 
-	static inline bool readfile(const std::filesystem::path& path, bytebuffer& contents_out)
+	/*
+	* reads up to 'buffer.size()' bytes starting at 'offset' into a caller-provided buffer, nothing is allocated
+	* @param bytes_read - number of bytes read, less than 'buffer.size()' if the file ends before
+	*/
+	static inline bool readfile(const std::filesystem::path& path, std::span<uint8_t> buffer, size_t& bytes_read, uint64_t offset = 0u)
 	{
+		bytes_read = 0;
 		try
 		{
 			std::ifstream file_reader(path, std::ifstream::binary);
-			if (file_reader.bad())
+			if (!file_reader.is_open())
 			{
 				throw std::runtime_error("file not found");
 			}
-			size_t file_size = std::filesystem::file_size(path);
-			for (size_t i = 0; i < file_size; i++)
+			if (offset && !file_reader.seekg(static_cast<std::streamoff>(offset)))
+			{
+				throw std::runtime_error("offset out of range");
+			}
+			// one sized read, the stream hands requests this large directly to the OS
+			file_reader.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+			bytes_read = static_cast<size_t>(file_reader.gcount());
+			if (file_reader.bad())
 			{
-				contents_out.emplace_back(static_cast<uint8_t>(file_reader.get()));
+				throw std::runtime_error("read failed");
 			}
-			file_reader.close();
 		}
 		catch (const std::exception& e)
 		{
@@ -81,20 +146,173 @@ namespace util
 		return true;
 	}
 
-	static inline bool writetofile(const std::filesystem::path& path, const bytebuffer& contents)
+	/*
+	* appends the contents of the file to 'contents_out', which is grown once to the file size
+	*/
+	static inline bool readfile(const std::filesystem::path& path, bytebuffer& contents_out)
 	{
+		size_t file_size = 0;
 		try
 		{
-			std::ofstream file_writer(path, std::ofstream::app | std::ofstream::binary);
-			if (file_writer.bad())
+			file_size = static_cast<size_t>(std::filesystem::file_size(path));
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "exception thrown while trying to read file '" << path.string() << "': " << e.what() << std::endl;
+			return false;
+		}
+		size_t old_size = contents_out.size();
+		contents_out.resize(old_size + file_size);
+		size_t bytes_read = 0;
+		bool res = readfile(path, std::span<uint8_t>(contents_out.data() + old_size, file_size), bytes_read);
+		contents_out.resize(old_size + bytes_read); // the file may have shrunk in the meantime
+		return res;
+	}
+
+	namespace _io
+	{
+		static inline void write(const std::filesystem::path& path, std::span<const uint8_t> contents, std::ios_base::openmode mode)
+		{
+			std::ofstream file_writer(path, mode | std::ofstream::binary);
+			if (!file_writer.is_open())
 			{
 				throw std::runtime_error("file not found");
 			}
-			for (size_t i = 0; i < contents.size(); i++)
+			file_writer.write(reinterpret_cast<const char*>(contents.data()), static_cast<std::streamsize>(contents.size()));
+			file_writer.close();
+			if (!file_writer)
 			{
-				file_writer.put(contents[i]);
+				throw std::runtime_error("write failed");
 			}
-			file_writer.close();
+		}
+
+		/*
+		* file opened for reading and writing at explicit offsets (pread/pwrite, ReadFile/WriteFile with an offset),
+		* closed on destruction
+		*/
+		class positional_file
+		{
+		public:
+			explicit positional_file(const std::filesystem::path& path)
+			{
+#if defined(_WIN32)
+				handle = CreateFileW(path.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+				if (handle == INVALID_HANDLE_VALUE)
+#else
+				handle = ::open(path.c_str(), O_RDWR | O_CLOEXEC);
+				if (handle < 0)
+#endif
+				{
+					throw std::runtime_error("file not found");
+				}
+			}
+
+			positional_file(const positional_file&) = delete;
+			positional_file& operator=(const positional_file&) = delete;
+
+			~positional_file()
+			{
+#if defined(_WIN32)
+				CloseHandle(handle);
+#else
+				::close(handle);
+#endif
+			}
+
+			uint64_t size() const
+			{
+#if defined(_WIN32)
+				LARGE_INTEGER file_size;
+				if (!GetFileSizeEx(handle, &file_size))
+#else
+				struct stat file_stat;
+				if (::fstat(handle, &file_stat) != 0)
+#endif
+				{
+					throw std::runtime_error("could not determine file size");
+				}
+#if defined(_WIN32)
+				return static_cast<uint64_t>(file_size.QuadPart);
+#else
+				return static_cast<uint64_t>(file_stat.st_size);
+#endif
+			}
+
+			// reads exactly 'size' bytes at 'offset'
+			void read_at(uint8_t* data, size_t size, uint64_t offset) const
+			{
+				while (size)
+				{
+					size_t done = transfer(data, size, offset, false);
+					if (!done)
+					{
+						throw std::runtime_error("unexpected end of file");
+					}
+					data += done;
+					size -= done;
+					offset += done;
+				}
+			}
+
+			// writes exactly 'size' bytes at 'offset', the file grows if needed
+			void write_at(const uint8_t* data, size_t size, uint64_t offset) const
+			{
+				while (size)
+				{
+					size_t done = transfer(const_cast<uint8_t*>(data), size, offset, true);
+					if (!done)
+					{
+						throw std::runtime_error("write made no progress");
+					}
+					data += done;
+					size -= done;
+					offset += done;
+				}
+			}
+
+		private:
+#if defined(_WIN32)
+			HANDLE handle = INVALID_HANDLE_VALUE;
+#else
+			int handle = -1;
+#endif
+
+			// single read or write call, may transfer less than 'size' bytes
+			size_t transfer(uint8_t* data, size_t size, uint64_t offset, bool write) const
+			{
+#if defined(_WIN32)
+				OVERLAPPED position{};
+				position.Offset = static_cast<DWORD>(offset);
+				position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+				DWORD chunk = static_cast<DWORD>(std::min<size_t>(size, 1u << 30));
+				DWORD done = 0;
+				BOOL success = write ? WriteFile(handle, data, chunk, &done, &position) : ReadFile(handle, data, chunk, &done, &position);
+				if (!success && (write || GetLastError() != ERROR_HANDLE_EOF))
+				{
+					throw std::runtime_error(write ? "write failed" : "read failed");
+				}
+				return static_cast<size_t>(done);
+#else
+				ssize_t done = write ? ::pwrite(handle, data, size, static_cast<off_t>(offset)) : ::pread(handle, data, size, static_cast<off_t>(offset));
+				if (done < 0)
+				{
+					if (errno == EINTR)
+					{
+						return transfer(data, size, offset, write);
+					}
+					throw std::runtime_error(write ? "write failed" : "read failed");
+				}
+				return static_cast<size_t>(done);
+#endif
+			}
+		};
+	}
+
+	static inline bool writetofile(const std::filesystem::path& path, std::span<const uint8_t> contents)
+	{
+		try
+		{
+			_io::write(path, contents, std::ofstream::app);
 		}
 		catch (const std::exception& e)
 		{
@@ -104,24 +322,65 @@ namespace util
 		return true;
 	}
 
+	static inline bool writetofile(const std::filesystem::path& path, const bytebuffer& contents)
+	{
+		return writetofile(path, std::span<const uint8_t>(contents));
+	}
+
+	static inline bool overwritefile(const std::filesystem::path& path, std::span<const uint8_t> contents)
+	{
+		try
+		{
+			_io::write(path, contents, std::ofstream::trunc);
+		}
+		catch (const std::exception& e)
+		{
+			std::cerr << "exception thrown while trying to overwrite file '" << path.string() << "': " << e.what() << std::endl;
+			return false;
+		}
+		return true;
+	}
+
 	static inline bool overwritefile(const std::filesystem::path& path, const bytebuffer& contents)
+	{
+		return overwritefile(path, std::span<const uint8_t>(contents));
+	}
+
+	/*
+	* inserts 'contents' in front of the byte at 'start_index'. only the tail behind 'start_index' is moved,
+	* in chunks of at most 'chunk_size' bytes from the end backwards, so memory use stays constant
+	* and the I/O is proportional to the tail.
+	*/
+	static inline bool insertinfile(const std::filesystem::path& path, std::span<const uint8_t> contents, uint64_t start_index = 0u, size_t chunk_size = 1u << 20)
 	{
 		try
 		{
-			std::ofstream file_writer(path, std::ofstream::binary);
-			if (file_writer.bad())
+			_io::positional_file file(path);
+			uint64_t file_size = file.size();
+			if (start_index >= file_size)
 			{
-				throw std::runtime_error("file not found");
+				throw std::runtime_error("index out of range");
 			}
-			for (size_t i = 0; i < contents.size(); i++)
+			if (contents.empty())
 			{
-				file_writer.put(contents[i]);
+				return true;
 			}
-			file_writer.close();
+
+			// moving back to front never overwrites tail bytes that still have to be moved
+			bytebuffer chunk(static_cast<size_t>(std::min<uint64_t>(std::max<size_t>(chunk_size, 1u), file_size - start_index)));
+			uint64_t remaining = file_size - start_index;
+			while (remaining)
+			{
+				size_t chunk_length = static_cast<size_t>(std::min<uint64_t>(remaining, chunk.size()));
+				remaining -= chunk_length;
+				file.read_at(chunk.data(), chunk_length, start_index + remaining);
+				file.write_at(chunk.data(), chunk_length, start_index + remaining + contents.size());
+			}
+			file.write_at(contents.data(), contents.size(), start_index);
 		}
 		catch (const std::exception& e)
 		{
-			std::cerr << "exception thrown while trying to overwrite file '" << path.string() << "': " << e.what() << std::endl;
+			std::cerr << "exception thrown while trying to insert to file '" << path.string() << "': " << e.what() << std::endl;
 			return false;
 		}
 		return true;
@@ -129,44 +388,251 @@ namespace util
 
 	static inline bool insertinfile(const std::filesystem::path& path, const bytebuffer& contents, uint64_t start_index = 0u)
 	{
-		try
+		return insertinfile(path, std::span<const uint8_t>(contents), start_index);
+	}
+
+	/*
+	* memory mapping of a whole file, read-only or read-write
+	*
+	* the mapping is released on destruction. empty files are valid and map to an empty view.
+	* pages are only loaded on access, so files larger than the physical memory can be mapped as well
+	* (as long as they fit the address space). a read-write mapping writes through to the file but
+	* cannot change its size.
+	*/
+	class mapped_file
+	{
+	public:
+		enum class mode
+		{
+			read_only,
+			read_write
+		};
+
+		/*
+		* expected access pattern, lets the OS tune read-ahead and page eviction
+		*/
+		enum class access
+		{
+			normal,
+			sequential,
+			random,
+			willneed // start loading the whole file now
+		};
+
+		mapped_file() = default;
+
+		/*
+		* @throws std::runtime_error - if the file cannot be opened or mapped
+		*/
+		explicit mapped_file(const std::filesystem::path& path, mode map_mode = mode::read_only, access hint = access::normal)
+		{
+			open(path, map_mode, hint);
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		mapped_file(mapped_file&& other) noexcept
+			: mapping(other.mapping), mapping_size(other.mapping_size), is_writable(other.is_writable)
 		{
-			bytebuffer fcontents;
-			readfile(path, fcontents);
-			if (start_index >= fcontents.size())
+			other.mapping = nullptr;
+			other.mapping_size = 0;
+			other.is_writable = false;
+		}
+
+		mapped_file& operator=(mapped_file&& other) noexcept
+		{
+			if (this != &other)
 			{
-				throw std::runtime_error("index out of range");
+				close();
+				mapping = other.mapping;
+				mapping_size = other.mapping_size;
+				is_writable = other.is_writable;
+				other.mapping = nullptr;
+				other.mapping_size = 0;
+				other.is_writable = false;
 			}
+			return *this;
+		}
 
-			bytebuffer before_insert = subvector(fcontents, 0, start_index);
-			bytebuffer after_insert = subvector(fcontents, start_index, fcontents.size() - 1);
+		~mapped_file()
+		{
+			close();
+		}
 
-			std::ofstream file_writer(path, std::ofstream::binary);
-			if (file_writer.bad())
+		/*
+		* maps 'path', releasing the previous mapping
+		* @throws std::runtime_error - if the file cannot be opened or mapped
+		*/
+		void open(const std::filesystem::path& path, mode map_mode = mode::read_only, access hint = access::normal)
+		{
+			close();
+			bool writable = map_mode == mode::read_write;
+#if defined(_WIN32)
+			// windows takes the access pattern as a hint for its file cache when opening
+			DWORD flags = FILE_ATTRIBUTE_NORMAL;
+			if (hint == access::sequential) { flags |= FILE_FLAG_SEQUENTIAL_SCAN; }
+			if (hint == access::random) { flags |= FILE_FLAG_RANDOM_ACCESS; }
+			HANDLE file = CreateFileW(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ,
+				writable ? FILE_SHARE_READ | FILE_SHARE_WRITE : FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+			if (file == INVALID_HANDLE_VALUE)
 			{
-				throw std::runtime_error("file not found");
+				throw std::runtime_error("could not open file '" + path.string() + "'");
 			}
-			for (size_t i = 0; i < before_insert.size(); i++)
+			LARGE_INTEGER file_size;
+			if (!GetFileSizeEx(file, &file_size))
 			{
-				file_writer.put(before_insert[i]);
+				CloseHandle(file);
+				throw std::runtime_error("could not determine size of file '" + path.string() + "'");
 			}
-			for (size_t i = 0; i < contents.size(); i++)
+			if (static_cast<uint64_t>(file_size.QuadPart) > SIZE_MAX)
 			{
-				file_writer.put(contents[i]);
+				CloseHandle(file);
+				throw std::runtime_error("file '" + path.string() + "' exceeds the address space");
 			}
-			for (size_t i = 0; i < after_insert.size(); i++)
+			if (file_size.QuadPart > 0)
 			{
-				file_writer.put(after_insert[i]);
+				HANDLE file_mapping = CreateFileMappingW(file, nullptr, writable ? PAGE_READWRITE : PAGE_READONLY, 0, 0, nullptr);
+				void* view = file_mapping ? MapViewOfFile(file_mapping, writable ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, 0) : nullptr;
+				if (file_mapping) { CloseHandle(file_mapping); }
+				if (!view)
+				{
+					CloseHandle(file);
+					throw std::runtime_error("could not map file '" + path.string() + "'");
+				}
+				mapping = static_cast<uint8_t*>(view);
+				mapping_size = static_cast<size_t>(file_size.QuadPart);
 			}
-			file_writer.close();
+			CloseHandle(file);
+#else
+			int file = ::open(path.c_str(), (writable ? O_RDWR : O_RDONLY) | O_CLOEXEC);
+			if (file < 0)
+			{
+				throw std::runtime_error("could not open file '" + path.string() + "'");
+			}
+			struct stat file_stat;
+			if (::fstat(file, &file_stat) != 0)
+			{
+				::close(file);
+				throw std::runtime_error("could not determine size of file '" + path.string() + "'");
+			}
+			if (static_cast<uint64_t>(file_stat.st_size) > SIZE_MAX)
+			{
+				::close(file);
+				throw std::runtime_error("file '" + path.string() + "' exceeds the address space");
+			}
+			if (file_stat.st_size > 0)
+			{
+				void* view = ::mmap(nullptr, static_cast<size_t>(file_stat.st_size), writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, file, 0);
+				if (view == MAP_FAILED)
+				{
+					::close(file);
+					throw std::runtime_error("could not map file '" + path.string() + "'");
+				}
+				mapping = static_cast<uint8_t*>(view);
+				mapping_size = static_cast<size_t>(file_stat.st_size);
+			}
+			::close(file); // the mapping stays valid without the descriptor
+#endif
+			is_writable = writable;
+			advise(hint);
 		}
-		catch (const std::exception& e)
+
+		/*
+		* releases the mapping, the object is empty afterwards
+		*/
+		void close()
 		{
-			std::cerr << "exception thrown while trying to insert to file '" << path.string() << "': " << e.what() << std::endl;
-			return false;
+			if (mapping)
+			{
+#if defined(_WIN32)
+				UnmapViewOfFile(mapping);
+#else
+				::munmap(mapping, mapping_size);
+#endif
+			}
+			mapping = nullptr;
+			mapping_size = 0;
+			is_writable = false;
 		}
-		return true;
-	}
+
+		/*
+		* passes an access pattern hint for the mapped pages to the OS (madvise), can be changed at any time.
+		* on windows only 'willneed' has an effect here, the other hints are taken by open()
+		*/
+		void advise(access hint) const
+		{
+			if (!mapping || hint == access::normal)
+			{
+				return;
+			}
+#if defined(_WIN32)
+#if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602 // PrefetchVirtualMemory needs windows 8
+			if (hint == access::willneed)
+			{
+				WIN32_MEMORY_RANGE_ENTRY range{ mapping, mapping_size };
+				PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+			}
+#endif
+#else
+			int advice = MADV_NORMAL;
+			switch (hint)
+			{
+			case access::sequential: advice = MADV_SEQUENTIAL; break;
+			case access::random: advice = MADV_RANDOM; break;
+			case access::willneed: advice = MADV_WILLNEED; break;
+			default: break;
+			}
+			::madvise(mapping, mapping_size, advice); // only a hint, failing is harmless
+#endif
+		}
+
+		/*
+		* writes modified pages back to the file before returning
+		* @throws std::runtime_error - if writing back fails
+		*/
+		void flush()
+		{
+			if (!mapping || !is_writable)
+			{
+				return;
+			}
+#if defined(_WIN32)
+			if (!FlushViewOfFile(mapping, 0))
+#else
+			if (::msync(mapping, mapping_size, MS_SYNC) != 0)
+#endif
+			{
+				throw std::runtime_error("could not write back mapped file");
+			}
+		}
+
+		const uint8_t* data() const { return mapping; }
+		size_t size() const { return mapping_size; }
+		bool empty() const { return !mapping_size; }
+		bool writable() const { return is_writable; }
+
+		std::span<const uint8_t> bytes() const { return std::span<const uint8_t>(mapping, mapping_size); }
+		std::string_view view() const { return std::string_view(reinterpret_cast<const char*>(mapping), mapping_size); }
+
+		/*
+		* @returns the mapped bytes for writing
+		* @throws std::runtime_error - if the file was mapped read-only
+		*/
+		std::span<uint8_t> writable_bytes()
+		{
+			if (mapping && !is_writable)
+			{
+				throw std::runtime_error("file is mapped read-only");
+			}
+			return std::span<uint8_t>(mapping, mapping_size);
+		}
+
+	private:
+		uint8_t* mapping = nullptr;
+		size_t mapping_size = 0;
+		bool is_writable = false;
+	};
 }
 ////////////////////////////////////////
 #endif
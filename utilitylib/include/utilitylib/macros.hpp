@@ -38,5 +38,16 @@ inline void setval_##name(type t) \
 UTIL_GET(type, name) \
 UTIL_SET(type, name)
 ////////////////////////////////////////
+/// software prefetch hint, no-op where unsupported
+////////////////////////////////////////
+#if defined(__GNUC__) || defined(__clang__)
+#define UTIL_PREFETCH(addr) __builtin_prefetch(static_cast<const void*>(addr))
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#define UTIL_PREFETCH(addr) _mm_prefetch(reinterpret_cast<const char*>(addr), _MM_HINT_T0)
+#else
+#define UTIL_PREFETCH(addr) ((void)(addr))
+#endif
+////////////////////////////////////////
 #endif
 ////////////////////////////////////////
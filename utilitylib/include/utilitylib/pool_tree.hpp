@@ -0,0 +1,654 @@
+////////////////////////////////////////
+/// general utility header-only-library
+/// for convenience methods/types in C++
+/// 2025 Julian Benzel
+////////////////////////////////////////
+/// index-based tree datastructure
+////////////////////////////////////////
+#ifndef UTIL_POOL_TREE_HPP
+#define UTIL_POOL_TREE_HPP
+////////////////////////////////////////
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <iterator>
+#include <vector>
+#include <functional>
+////////////////////////////////////////
+namespace util
+{
+	////////////////////////////////////////
+	/*
+	 * C++ implementation of an iterable tree-data-structure, alternative to util::tree
+	 *
+	 * instead of leaving ownership with the nodes, every node lives in one contiguous pool (std::vector)
+	 * and refers to adjacent nodes (parent, first/last child, next/previous sibling) by 32-bit indices.
+	 * erased slots are put on a free-list and reused by later insertions.
+	 *
+	 * because the pool may reallocate, nodes are not handed out by reference but as light-weight handles
+	 * (tree, index, generation). every slot carries a generation counter that is bumped when the slot
+	 * is freed, so a handle to an erased node is detected and throws instead of silently aliasing a new node.
+	 *
+	 * features:
+	 * - same interface as util::tree (emplace, find, filter, iterator, erase, concatenation)
+	 * - no per-node allocation, no reference counting
+	 * - iteration is non-recursive and O(1) amortized per step
+	 * - size() is O(1), copying the tree copies the pool in one go
+	 */
+	////////////////////////////////////////
+	template <typename _Ty>
+	class pool_tree
+	{
+	public:
+		////////////////////////////////////////
+		/// forward and using declarations
+		////////////////////////////////////////
+		class node;
+		class iterator;
+
+		friend node;
+		friend iterator;
+
+		using value_type = _Ty;
+		using index_type = std::uint32_t;
+		using generation_type = std::uint32_t;
+		using filter_condition = std::function<bool(const value_type&)>;
+
+		static constexpr index_type npos = std::numeric_limits<index_type>::max();
+
+	private:
+
+		////////////////////////////////////////
+		/// pool slot
+		////////////////////////////////////////
+
+		struct slot
+		{
+			std::optional<value_type> m_val;
+			index_type m_parent = npos;
+			index_type m_first_child = npos;
+			index_type m_last_child = npos;
+			index_type m_next_sibling = npos; // also links the free-list
+			index_type m_prev_sibling = npos;
+			index_type m_depth = 0U;
+			generation_type m_generation = 0U;
+			bool m_alive = false;
+		};
+
+		static constexpr index_type root_index = 0U;
+
+		std::vector<slot> m_pool;
+		index_type m_free_head = npos;
+		std::size_t m_size = 0ULL;
+
+	public:
+
+		////////////////////////////////////////
+		/// node handle
+		////////////////////////////////////////
+
+		class node
+		{
+			friend pool_tree;
+			friend iterator;
+
+			pool_tree* m_tree = nullptr;
+			index_type m_index = npos;
+			generation_type m_generation = 0U;
+
+			node(pool_tree* _tree, index_type _index) : m_tree(_tree), m_index(_index), m_generation(_tree->m_pool[_index].m_generation) {}
+
+			slot& _slot() const {
+				if (!valid()) { throw std::runtime_error("node handle is stale or empty"); }
+				return m_tree->m_pool[m_index];
+			}
+
+			node _make(index_type _index) const { return node(m_tree, _index); }
+
+		public:
+
+			node() = default;
+
+			////////////////////////////////////////
+			/// value and adjacent node access
+			////////////////////////////////////////
+
+			/*
+			 * @returns if the handle still refers to a node of its tree
+			 */
+			bool valid() const {
+				return m_tree && m_index < m_tree->m_pool.size()
+					&& m_tree->m_pool[m_index].m_alive && m_tree->m_pool[m_index].m_generation == m_generation;
+			}
+			/*
+			 * @brief convenience value setter
+			 * @param _val - the node's new value
+			 */
+			node& operator=(const value_type& _val) { _slot().m_val = _val; return *this; }
+			/*
+			 * @returns reference to the value of the node
+			 * @brief the reference is invalidated by insertions into the tree
+			 */
+			value_type& value() const { slot& _s = _slot(); if (_s.m_val) { return *_s.m_val; } throw std::runtime_error("value of node was nullptr"); }
+			/*
+			 * @returns distance from the node to the root of the tree
+			 */
+			std::size_t depth() const { return _slot().m_depth; }
+			/*
+			 * @returns handle to parent-node (the root-node for first-level nodes)
+			 * @throws std::runtime_error - if called on the root-node
+			 */
+			node parent() const {
+				index_type _parent = _slot().m_parent;
+				if (_parent == npos) { throw std::runtime_error("root node has no parent"); }
+				return _make(_parent);
+			}
+			/*
+			 * @returns if the node has any sub-nodes
+			 */
+			bool has_children() const { return _slot().m_first_child != npos; }
+			/*
+			 * @returns handle to next sibling-node, if there is one
+			 * @throws std::runtime_error - if called on the last sibling
+			 */
+			node next_sibling() const {
+				index_type _next = _slot().m_next_sibling;
+				if (_next == npos) { throw std::runtime_error("no next sibling"); }
+				return _make(_next);
+			}
+			/*
+			 * @returns handle to previous sibling-node, if there is one
+			 * @throws std::runtime_error - if called on the first sibling
+			 */
+			node prev_sibling() const {
+				index_type _prev = _slot().m_prev_sibling;
+				if (_prev == npos) { throw std::runtime_error("no previous sibling"); }
+				return _make(_prev);
+			}
+			/*
+			 * @returns handles to child-nodes
+			 */
+			std::vector<node> children() const {
+				std::vector<node> _res;
+				for (index_type _iter = _slot().m_first_child; _iter != npos; _iter = m_tree->m_pool[_iter].m_next_sibling) {
+					_res.emplace_back(_make(_iter));
+				}
+				return _res;
+			}
+
+			////////////////////////////////////////
+			/// modifiers
+			////////////////////////////////////////
+
+			/*
+			 * @brief create new node at the back of this node's children
+			 * @param _val - value of the child node
+			 * @returns handle to the new node
+			 */
+			node emplace_back(const value_type& _val) const {
+				_slot();
+				return _make(m_tree->_emplace_child(m_index, _val, false));
+			}
+			/*
+			 * @brief create new node at the front of this node's children
+			 * @param _val - value of the child node
+			 * @returns handle to the new node
+			 */
+			node emplace_front(const value_type& _val) const {
+				_slot();
+				return _make(m_tree->_emplace_child(m_index, _val, true));
+			}
+			/*
+			 * @brief insert a new node as next sibling node
+			 * @param _val - the new node's value
+			 * @returns handle to the new node
+			 */
+			node emplace_next_sibling(const value_type& _val) const {
+				if (_slot().m_parent == npos) { throw std::runtime_error("root node cannot have siblings"); }
+				return _make(m_tree->_emplace_sibling(m_index, _val, true));
+			}
+			/*
+			 * @brief insert a new node as previous sibling node
+			 * @param _val - the new node's value
+			 * @returns handle to the new node
+			 */
+			node emplace_prev_sibling(const value_type& _val) const {
+				if (_slot().m_parent == npos) { throw std::runtime_error("root node cannot have siblings"); }
+				return _make(m_tree->_emplace_sibling(m_index, _val, false));
+			}
+			/*
+			 * @brief concatenates every child-node of the tree's root node to this node
+			 */
+			void concatenate(const pool_tree& _tree) const {
+				_slot();
+				m_tree->_copy_nodes(_tree, root_index, m_index);
+			}
+
+			friend bool operator==(const node& a, const node& b) { return a.m_tree == b.m_tree && a.m_index == b.m_index && a.m_generation == b.m_generation; }
+			friend bool operator!=(const node& a, const node& b) { return !(a == b); }
+		};
+
+		////////////////////////////////////////
+		/// iterators
+		////////////////////////////////////////
+
+		class iterator
+		{
+			friend pool_tree;
+
+			node m_node; // m_index == root_index marks the end
+
+			iterator(pool_tree* _tree, index_type _index) : m_node(_tree, _index) {}
+
+			bool _is_end() const { return m_node.m_index == root_index; }
+			const pool_tree* _tree() const { return m_node.m_tree; }
+			index_type _index() const { return m_node.m_index; }
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = node;
+			using difference_type = std::ptrdiff_t;
+			using pointer = node*;
+			using reference = node&;
+
+			iterator() = default;
+
+			node* operator->() { if (_is_end()) { throw std::runtime_error("cannot dereference end iterator"); } return &m_node; }
+			node& operator*() { if (_is_end()) { throw std::runtime_error("cannot dereference end iterator"); } return m_node; }
+
+			iterator& operator++() {
+				if (_is_end()) { throw std::runtime_error("cannot increment end iterator"); }
+				m_node = m_node._make(m_node.m_tree->_next_preorder(m_node.m_index));
+				return *this;
+			}
+
+			iterator operator++(int) {
+				iterator _iter(*this);
+				this->operator++();
+				return _iter;
+			}
+
+			friend bool operator==(const iterator& i, const iterator& j) {
+				if (i._tree() != j._tree()) { throw std::runtime_error("cannot compare iterators of different trees"); }
+				return i._index() == j._index();
+			}
+			friend bool operator!=(const iterator& i, const iterator& j) { return !(i == j); }
+		};
+		/*
+		 * @returns iterator to first node of the tree, or to the end if there are none
+		 */
+		iterator begin() {
+			index_type _first = m_pool[root_index].m_first_child;
+			return iterator(this, _first != npos ? _first : root_index);
+		}
+		/*
+		 * @returns iterator to end/header node of the tree
+		 */
+		iterator end() {
+			return iterator(this, root_index);
+		}
+		/*
+		 * @returns iterator pointing to the given node
+		 */
+		iterator to_iterator(const node& _node) {
+			if (_node.m_tree != this) { throw std::runtime_error("node belongs to a different tree"); }
+			_node._slot();
+			return iterator(this, _node.m_index);
+		}
+
+		////////////////////////////////////////
+		/// modifiers
+		////////////////////////////////////////
+		/*
+		 * @brief emplaces new node which holds value '_val' as last child of the root-node
+		 * @param _val - the value which the node will hold
+		 * @returns handle to the new node
+		 */
+		node emplace_back(const value_type& _val) {
+			return node(this, _emplace_child(root_index, _val, false));
+		}
+		/*
+		 * @brief emplaces new node which holds value '_val' as first child of the root-node
+		 * @param _val - the value which the node will hold
+		 * @returns handle to the new node
+		 */
+		node emplace_front(const value_type& _val) {
+			return node(this, _emplace_child(root_index, _val, true));
+		}
+		/*
+		 * @brief preallocates pool storage for '_count' nodes
+		 */
+		void reserve(std::size_t _count) {
+			m_pool.reserve(_count + 1ULL);
+		}
+
+		////////////////////////////////////////
+		/// node access
+		////////////////////////////////////////
+
+		/*
+		 * @brief searches the tree for a given value
+		 * @param _val - the value to look for
+		 * @returns handle to the first node found with that value
+		 */
+		node find_first(const value_type& _val) {
+			return *find_first_iterator(_val);
+		}
+		/*
+		 * @brief searches the tree for a given value
+		 * @param _val - the value to look for
+		 * @returns iterator to the first node found with that value
+		 */
+		iterator find_first_iterator(const value_type& _val) {
+			for (iterator _iter = begin(); _iter != end(); ++_iter) {
+				if (_iter->value() == _val) { return _iter; }
+			}
+			throw std::runtime_error("tree does not contain node with given value");
+		}
+		/*
+		 * @brief searches the tree for all nodes of a given value
+		 * @param _val - the value to look for
+		 * @returns handles to all nodes holding that value
+		 */
+		std::vector<node> find(const value_type& _val) {
+			return filter([&_val](const value_type& _other) { return _other == _val; });
+		}
+		/*
+		 * @brief searches the tree for all nodes of a given value
+		 * @param _val - the value to look for
+		 * @returns iterators to all nodes holding that value
+		 */
+		std::vector<iterator> find_iterators(const value_type& _val) {
+			return filter_iterators([&_val](const value_type& _other) { return _other == _val; });
+		}
+		/*
+		 * @brief searches the tree for all nodes for which the filter_condition evaluates to true
+		 * @param _cond - function of the signature '[](const value_type&) -> bool'
+		 * @returns handles to all nodes satisfying this condition
+		 */
+		std::vector<node> filter(const filter_condition& _cond) {
+			std::vector<node> _res;
+			for (iterator _iter = begin(); _iter != end(); ++_iter) {
+				if (_cond(_iter->value())) {
+					_res.emplace_back(*_iter);
+				}
+			}
+			return _res;
+		}
+		/*
+		 * @brief searches the tree for all nodes for which the filter_condition evaluates to true
+		 * @param _cond - function of the signature '[](const value_type&) -> bool'
+		 * @returns iterators to all nodes satisfying this condition
+		 */
+		std::vector<iterator> filter_iterators(const filter_condition& _cond) {
+			std::vector<iterator> _res;
+			for (iterator _iter = begin(); _iter != end(); ++_iter) {
+				if (_cond(_iter->value())) {
+					_res.emplace_back(_iter);
+				}
+			}
+			return _res;
+		}
+
+		/*
+		 * @brief erases every branch of the tree, handles to old nodes become stale
+		 */
+		void clear() {
+			for (index_type _i = 1U; _i < m_pool.size(); ++_i) {
+				if (m_pool[_i].m_alive) { _free_slot(_i); }
+			}
+			m_pool[root_index].m_first_child = npos;
+			m_pool[root_index].m_last_child = npos;
+			m_size = 0ULL;
+		}
+		/*
+		 * @brief erases node at given iterator
+		 * @brief will also erase every child node from the tree, handles and iterators to these nodes become stale
+		 * @param _where - the node to erase
+		 * @returns iterator to the next valid node
+		 */
+		iterator erase(iterator _where) {
+			if (_where == end()) { throw std::runtime_error("cannot erase end-iterator"); }
+			index_type _index = _where.m_node.m_index;
+			_where.m_node._slot();
+			index_type _next = _next_skip_subtree(_index);
+			_unlink(_index);
+			_free_subtree(_index);
+			return iterator(this, _next);
+		}
+
+		////////////////////////////////////////
+		/// size
+		////////////////////////////////////////
+
+		/*
+		 * @returns total number of nodes
+		 */
+		std::size_t size() const {
+			return m_size;
+		}
+
+		////////////////////////////////////////
+		/// special member functions
+		////////////////////////////////////////
+
+		/*
+		 * @brief std::swap specialization by swapping the pools
+		 */
+		friend void swap(pool_tree& a, pool_tree& b) {
+			std::swap(a.m_pool, b.m_pool);
+			std::swap(a.m_free_head, b.m_free_head);
+			std::swap(a.m_size, b.m_size);
+		}
+		/*
+		 * @brief default constructor
+		 */
+		pool_tree() {
+			m_pool.emplace_back();
+			m_pool[root_index].m_alive = true;
+		}
+		/*
+		 * @brief construct a new tree from an existing node (and all it's children)
+		 */
+		pool_tree(const node& _node) : pool_tree() {
+			_node._slot();
+			index_type _new = _emplace_child(root_index, _node.value(), false);
+			_copy_nodes(*_node.m_tree, _node.m_index, _new);
+		}
+		/*
+		 * @brief copy constructor and assignment operator make a deep copy of the pool, preserving tree hierarchy
+		 */
+		pool_tree(const pool_tree&) = default;
+		pool_tree& operator=(const pool_tree&) = default;
+		/*
+		 * @brief move constructor and assignment operator take over the pool, the moved-from tree is left empty but usable
+		 */
+		pool_tree(pool_tree&& _other) noexcept : pool_tree() {
+			swap(*this, _other);
+		}
+		pool_tree& operator=(pool_tree&& _other) noexcept {
+			if (this != &_other) {
+				swap(*this, _other);
+				_other.clear();
+			}
+			return *this;
+		}
+
+	private:
+
+		////////////////////////////////////////
+		/// pool utility
+		////////////////////////////////////////
+
+		index_type _alloc_slot(const value_type& _val) {
+			index_type _index;
+			if (m_free_head != npos) {
+				_index = m_free_head;
+				slot& _new = m_pool[_index];
+				_new.m_val.emplace(_val);
+				m_free_head = _new.m_next_sibling;
+				_new.m_parent = npos;
+				_new.m_first_child = npos;
+				_new.m_last_child = npos;
+				_new.m_next_sibling = npos;
+				_new.m_prev_sibling = npos;
+				_new.m_alive = true;
+			}
+			else {
+				if (m_pool.size() >= npos) { throw std::length_error("pool_tree node capacity exceeded"); }
+				_index = static_cast<index_type>(m_pool.size());
+				// '_val' may refer into the pool, so the slot is finished before the pool grows and moves it
+				slot _new;
+				_new.m_val.emplace(_val);
+				_new.m_alive = true;
+				m_pool.push_back(std::move(_new));
+			}
+			++m_size;
+			return _index;
+		}
+
+		void _free_slot(index_type _index) {
+			slot& _old = m_pool[_index];
+			_old.m_val.reset();
+			_old.m_alive = false;
+			++_old.m_generation;
+			_old.m_next_sibling = m_free_head;
+			m_free_head = _index;
+		}
+
+		/*
+		 * @brief frees '_top' and all of its descendants without recursion.
+		 * @brief leaves are freed first and detached from their parent, so a parent becomes a leaf once its children are gone.
+		 */
+		void _free_subtree(index_type _top) {
+			index_type _iter = _top;
+			while (true) {
+				slot& _node = m_pool[_iter];
+				if (_node.m_first_child != npos) { _iter = _node.m_first_child; continue; }
+				index_type _parent = _node.m_parent;
+				index_type _next = _node.m_next_sibling;
+				_free_slot(_iter);
+				--m_size;
+				if (_iter == _top) { break; }
+				m_pool[_parent].m_first_child = _next;
+				_iter = _next != npos ? _next : _parent;
+			}
+		}
+
+		index_type _emplace_child(index_type _parent, const value_type& _val, bool _front) {
+			index_type _new = _alloc_slot(_val);
+			slot& _child = m_pool[_new];
+			slot& _par = m_pool[_parent];
+			_child.m_parent = _parent;
+			_child.m_depth = _par.m_depth + 1U;
+			if (_par.m_first_child == npos) {
+				_par.m_first_child = _new;
+				_par.m_last_child = _new;
+			}
+			else if (_front) {
+				_child.m_next_sibling = _par.m_first_child;
+				m_pool[_par.m_first_child].m_prev_sibling = _new;
+				_par.m_first_child = _new;
+			}
+			else {
+				_child.m_prev_sibling = _par.m_last_child;
+				m_pool[_par.m_last_child].m_next_sibling = _new;
+				_par.m_last_child = _new;
+			}
+			return _new;
+		}
+
+		index_type _emplace_sibling(index_type _sibling, const value_type& _val, bool _after) {
+			index_type _new = _alloc_slot(_val);
+			slot& _ins = m_pool[_new];
+			slot& _sib = m_pool[_sibling];
+			slot& _par = m_pool[_sib.m_parent];
+			_ins.m_parent = _sib.m_parent;
+			_ins.m_depth = _sib.m_depth;
+			if (_after) {
+				_ins.m_prev_sibling = _sibling;
+				_ins.m_next_sibling = _sib.m_next_sibling;
+				if (_sib.m_next_sibling != npos) { m_pool[_sib.m_next_sibling].m_prev_sibling = _new; }
+				else { _par.m_last_child = _new; }
+				_sib.m_next_sibling = _new;
+			}
+			else {
+				_ins.m_next_sibling = _sibling;
+				_ins.m_prev_sibling = _sib.m_prev_sibling;
+				if (_sib.m_prev_sibling != npos) { m_pool[_sib.m_prev_sibling].m_next_sibling = _new; }
+				else { _par.m_first_child = _new; }
+				_sib.m_prev_sibling = _new;
+			}
+			return _new;
+		}
+
+		void _unlink(index_type _index) {
+			slot& _node = m_pool[_index];
+			slot& _par = m_pool[_node.m_parent];
+			if (_node.m_prev_sibling != npos) { m_pool[_node.m_prev_sibling].m_next_sibling = _node.m_next_sibling; }
+			else { _par.m_first_child = _node.m_next_sibling; }
+			if (_node.m_next_sibling != npos) { m_pool[_node.m_next_sibling].m_prev_sibling = _node.m_prev_sibling; }
+			else { _par.m_last_child = _node.m_prev_sibling; }
+			_node.m_prev_sibling = npos;
+			_node.m_next_sibling = npos;
+		}
+
+		////////////////////////////////////////
+		/// traversal utility
+		////////////////////////////////////////
+
+		/*
+		 * @returns next node in pre-order that is not part of the subtree of '_index' (root_index at the end)
+		 */
+		index_type _next_skip_subtree(index_type _index) const {
+			while (_index != root_index) {
+				const slot& _node = m_pool[_index];
+				if (_node.m_next_sibling != npos) { return _node.m_next_sibling; }
+				_index = _node.m_parent;
+			}
+			return root_index;
+		}
+
+		index_type _next_preorder(index_type _index) const {
+			const slot& _node = m_pool[_index];
+			if (_node.m_first_child != npos) { return _node.m_first_child; }
+			return _next_skip_subtree(_index);
+		}
+
+		/*
+		 * @brief non-recursive node copying utility, copies all children of '_src' in '_src_tree' below '_target'
+		 */
+		void _copy_nodes(const pool_tree& _src_tree, index_type _src, index_type _target) {
+			if (&_src_tree == this) {
+				pool_tree _tmp(_src_tree);
+				_copy_nodes(_tmp, _src, _target);
+				return;
+			}
+			index_type _src_iter = _src_tree.m_pool[_src].m_first_child;
+			index_type _target_parent = _target;
+			while (_src_iter != npos) {
+				const slot& _src_node = _src_tree.m_pool[_src_iter];
+				index_type _new = _emplace_child(_target_parent, *_src_node.m_val, false);
+				if (_src_node.m_first_child != npos) {
+					// descend
+					_src_iter = _src_node.m_first_child;
+					_target_parent = _new;
+					continue;
+				}
+				// ascend until there is a next sibling or the copied range is exhausted
+				while (_src_iter != npos && _src_tree.m_pool[_src_iter].m_next_sibling == npos) {
+					_src_iter = _src_tree.m_pool[_src_iter].m_parent;
+					if (_src_iter == _src) { _src_iter = npos; break; }
+					_target_parent = m_pool[_target_parent].m_parent;
+				}
+				if (_src_iter != npos) { _src_iter = _src_tree.m_pool[_src_iter].m_next_sibling; }
+			}
+		}
+	};
+
+	////////////////////////////////////////
+}
+////////////////////////////////////////
+#endif
+////////////////////////////////////////
@@ -12,27 +12,285 @@
 #include <stdexcept>
 #include <random>
 #include <vector>
+#include <span>
+#include <limits>
+#include <algorithm>
+#include <numbers>
+#include <utility>
+#include <unordered_set>
 #include <concepts>
 #include <cmath>
+#include "thread_pool.hpp"
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
 ////////////////////////////////////////
 namespace util
 {
-    /*
-     * tests if a number is prime by finding even divisors up to sqrt(_num)
-     * @param _num unsigned integer type to test
-     * @tparam numtype any type that satisfies std::unsigned_integral
-     * @returns true if _num is prime, otherwise false
-     */
-    template<typename numtype>
-        requires std::unsigned_integral<numtype>
-    static inline bool is_prime(const numtype& _num)
-    {
-        for (numtype _iter = 2U; _iter <= static_cast<numtype>(std::floor(std::sqrt(static_cast<double>(_num)))); ++_iter)
-        {
-            if (!(_num % _iter)) { return false; };
-        }
-        return true;
-    }
+	/*
+	* xoshiro256** (Blackman, Vigna), a small and fast generator with 256 bits of state.
+	* not suitable for cryptography. satisfies std::uniform_random_bit_generator,
+	* so it can drive the <random> distributions as well.
+	*/
+	class xoshiro256
+	{
+	public:
+		using result_type = uint64_t;
+
+		explicit xoshiro256(uint64_t seed_value = 0)
+		{
+			seed(seed_value);
+		}
+
+		/*
+		* expands 'seed_value' into the full state with splitmix64, as recommended by the authors
+		*/
+		void seed(uint64_t seed_value)
+		{
+			for (uint64_t& word : state)
+			{
+				seed_value += 0x9E3779B97F4A7C15ULL;
+				uint64_t mixed = seed_value;
+				mixed = (mixed ^ (mixed >> 30)) * 0xBF58476D1CE4E5B9ULL;
+				mixed = (mixed ^ (mixed >> 27)) * 0x94D049BB133111EBULL;
+				word = mixed ^ (mixed >> 31);
+			}
+		}
+
+		static constexpr result_type min()
+		{
+			return 0;
+		}
+
+		static constexpr result_type max()
+		{
+			return std::numeric_limits<result_type>::max();
+		}
+
+		result_type operator()()
+		{
+			const uint64_t res = rotl(state[1] * 5, 7) * 9;
+			const uint64_t shifted = state[1] << 17;
+			state[2] ^= state[0];
+			state[3] ^= state[1];
+			state[1] ^= state[2];
+			state[0] ^= state[3];
+			state[2] ^= shifted;
+			state[3] = rotl(state[3], 45);
+			return res;
+		}
+
+		/*
+		* fills 'out' with raw 64-bit random numbers
+		*/
+		void fill(std::span<uint64_t> out)
+		{
+			// the state lives in registers for the whole loop instead of being stored back after every number
+			uint64_t s0 = state[0], s1 = state[1], s2 = state[2], s3 = state[3];
+			for (uint64_t& value : out)
+			{
+				value = rotl(s1 * 5, 7) * 9;
+				const uint64_t shifted = s1 << 17;
+				s2 ^= s0;
+				s3 ^= s1;
+				s1 ^= s2;
+				s0 ^= s3;
+				s2 ^= shifted;
+				s3 = rotl(s3, 45);
+			}
+			state[0] = s0;
+			state[1] = s1;
+			state[2] = s2;
+			state[3] = s3;
+		}
+
+		/*
+		* advances the state by 2^128 steps, every jump starts a sequence that does not overlap the previous one
+		*/
+		void jump()
+		{
+			static constexpr uint64_t polynomial[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+			uint64_t jumped[4] = { 0, 0, 0, 0 };
+			for (uint64_t word : polynomial)
+			{
+				for (int bit = 0; bit < 64; bit++)
+				{
+					if (word & (1ULL << bit))
+					{
+						for (int i = 0; i < 4; i++) { jumped[i] ^= state[i]; }
+					}
+					(*this)();
+				}
+			}
+			for (int i = 0; i < 4; i++) { state[i] = jumped[i]; }
+		}
+
+	private:
+		uint64_t state[4];
+
+		static constexpr uint64_t rotl(uint64_t value, int shift)
+		{
+			return (value << shift) | (value >> (64 - shift));
+		}
+	};
+
+	namespace _random
+	{
+		// upper 64 bits of the 128-bit product
+		static inline uint64_t mul_hi(uint64_t a, uint64_t b)
+		{
+#if defined(__SIZEOF_INT128__)
+			return static_cast<uint64_t>((static_cast<unsigned __int128>(a) * b) >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+			return __umulh(a, b);
+#else
+			const uint64_t a_lo = a & 0xFFFFFFFFULL, a_hi = a >> 32;
+			const uint64_t b_lo = b & 0xFFFFFFFFULL, b_hi = b >> 32;
+			const uint64_t cross = (a_lo * b_lo >> 32) + (a_hi * b_lo & 0xFFFFFFFFULL) + a_lo * b_hi;
+			return a_hi * b_hi + (a_hi * b_lo >> 32) + (cross >> 32);
+#endif
+		}
+
+		/*
+		* unbiased number in [0, max_value] with Lemire's multiply-shift method, which rejects (and divides) only rarely
+		*/
+		template <typename Generator>
+		static inline uint64_t uniform_inclusive(Generator& generator, uint64_t max_value)
+		{
+			if (max_value == std::numeric_limits<uint64_t>::max())
+			{
+				return generator();
+			}
+			const uint64_t bound = max_value + 1;
+			uint64_t random = generator();
+			uint64_t low = random * bound;
+			if (low < bound)
+			{
+				const uint64_t threshold = (0 - bound) % bound;
+				while (low < threshold)
+				{
+					random = generator();
+					low = random * bound;
+				}
+			}
+			return mul_hi(random, bound);
+		}
+
+		static constexpr uint64_t splitmix64(uint64_t value)
+		{
+			value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+			return value ^ (value >> 31);
+		}
+
+		/*
+		* several xoshiro256** generators stepped side by side in plain loops, which compilers vectorize.
+		* the bulk sequences are cut into chunks of 'chunk' values, each with its own lanes seeded from
+		* (seed, chunk index), so any value of a sequence can be reached without generating everything before it.
+		* value v is step (v % chunk) / lanes of lane v % lanes in chunk v / chunk.
+		*/
+		struct lane_generator
+		{
+			static constexpr size_t lanes = 4;
+			static constexpr uint64_t chunk = 1024;
+			static constexpr size_t batch = 64;
+
+			uint64_t s0[lanes], s1[lanes], s2[lanes], s3[lanes];
+
+			void seed(uint64_t seed_value, uint64_t chunk_index)
+			{
+				// every lane state word is a distinct splitmix64 counter, so no two lanes or chunks start alike
+				const uint64_t base = splitmix64(seed_value);
+				for (size_t l = 0; l < lanes; l++)
+				{
+					const uint64_t counter = base + (chunk_index * lanes + l) * 4 * 0x9E3779B97F4A7C15ULL;
+					s0[l] = splitmix64(counter + 0x9E3779B97F4A7C15ULL);
+					s1[l] = splitmix64(counter + 2 * 0x9E3779B97F4A7C15ULL);
+					s2[l] = splitmix64(counter + 3 * 0x9E3779B97F4A7C15ULL);
+					s3[l] = splitmix64(counter + 4 * 0x9E3779B97F4A7C15ULL);
+				}
+			}
+
+			// values[s * lanes + l] = step s of lane l
+			void generate(uint64_t* values, size_t steps)
+			{
+				for (size_t s = 0; s < steps; s++)
+				{
+					for (size_t l = 0; l < lanes; l++)
+					{
+						const uint64_t res = s1[l] * 5;
+						values[s * lanes + l] = ((res << 7) | (res >> 57)) * 9;
+						const uint64_t shifted = s1[l] << 17;
+						s2[l] ^= s0[l];
+						s3[l] ^= s1[l];
+						s1[l] ^= s2[l];
+						s0[l] ^= s3[l];
+						s2[l] ^= shifted;
+						s3[l] = (s3[l] << 45) | (s3[l] >> 19);
+					}
+				}
+			}
+		};
+
+		/*
+		* calls 'func(i, values, n)' with the values [first_index + i, first_index + i + n) of the sequence 'seed'
+		* until 'count' values are through
+		*/
+		template <typename Func>
+		static inline void random_batches(uint64_t seed, uint64_t first_index, uint64_t count, Func&& func)
+		{
+			constexpr size_t lanes = lane_generator::lanes;
+			constexpr uint64_t chunk_steps = lane_generator::chunk / lanes;
+			lane_generator generator;
+			uint64_t values[lane_generator::batch];
+			for (uint64_t i = 0; i < count;)
+			{
+				const uint64_t index = first_index + i;
+				generator.seed(seed, index / lane_generator::chunk);
+				uint64_t step = index % lane_generator::chunk / lanes;
+				for (uint64_t skipped = 0; skipped < step; skipped += lane_generator::batch / lanes)
+				{
+					generator.generate(values, static_cast<size_t>(std::min<uint64_t>(lane_generator::batch / lanes, step - skipped)));
+				}
+				size_t skip = static_cast<size_t>(index % lanes);
+				while (step < chunk_steps && i < count)
+				{
+					const size_t steps = static_cast<size_t>(std::min<uint64_t>(lane_generator::batch / lanes, chunk_steps - step));
+					generator.generate(values, steps);
+					const size_t n = static_cast<size_t>(std::min<uint64_t>(count - i, steps * lanes - skip));
+					func(static_cast<size_t>(i), values + skip, n);
+					i += n;
+					step += steps;
+					skip = 0;
+				}
+			}
+		}
+
+		// value 'index' of the sequence 'seed' drawn again from an independent hash, 'retry' counts from 1
+		static inline uint64_t redraw(uint64_t seed, uint64_t index, uint32_t retry)
+		{
+			return splitmix64(splitmix64(seed ^ (static_cast<uint64_t>(retry) * 0xD1B54A32D192ED03ULL)) + index * 0x9E3779B97F4A7C15ULL);
+		}
+		// uniform double in [0, 1)
+		static inline double to_unit(uint64_t random)
+		{
+			return static_cast<double>(random >> 11) * 0x1.0p-53;
+		}
+	}
+
+	/*
+	* @returns generator of the calling thread, seeded from std::random_device on first use
+	*/
+	static inline xoshiro256& thread_generator()
+	{
+		thread_local xoshiro256 generator = []()
+		{
+			std::random_device random_device;
+			return xoshiro256((static_cast<uint64_t>(random_device()) << 32) ^ random_device());
+		}();
+		return generator;
+	}
+
 	/*
 	* random unsigned integer generation
 	* @param lower - the smallest possible random number
@@ -46,23 +304,14 @@ namespace util
 		{
 			throw std::invalid_argument("upper range cannot be smaller than lower range");
 		}
-		if (upper == lower)
-		{
-			return upper;
-		}
-
-		std::random_device random_device;
-		std::mt19937 random_number_generator(random_device());
-		std::uniform_int_distribution<std::mt19937::result_type> distribution(lower, upper);
-
-		return static_cast<uint64_t>(distribution(random_number_generator));
+		return lower + _random::uniform_inclusive(thread_generator(), upper - lower);
 	}
 	/*
 	* generates vector of random unique unsigned integers
 	* @param lower - the smallest possible random number
 	* @param upper - the largest possible random number
 	* @param size  - the amount of random numbers / the size of the vector
-	* @returns vector of random numbers possibly including 'lower' or 'upper'
+	* @returns vector of random numbers in random order, possibly including 'lower' or 'upper'
 	* @throws invalid_argument if upper < lower
 	* @throws invalid_argument if size is greater than the amount of numbers between 'lower' and 'upper'
 	*/
@@ -72,30 +321,503 @@ namespace util
 		{
 			throw std::invalid_argument("upper range cannot be smaller that lower range");
 		}
-		if (size - 1 > upper - lower)
+		if (size && size - 1 > upper - lower)
 		{
 			throw std::invalid_argument("not enough numbers in specified range to fulfill size requirements");
 		}
 
+		xoshiro256& generator = thread_generator();
+		const uint64_t max_offset = upper - lower;
 		std::vector<uint64_t> res;
-		std::vector<uint64_t> numbers;
+		res.reserve(size);
 
-		for (uint64_t i = lower; i <= upper; i++)
+		if (max_offset / 2 < size)
+		{
+			// dense: partial fisher-yates over the whole range, which is at most twice 'size'
+			for (uint64_t offset = 0; offset <= max_offset; offset++)
+			{
+				res.emplace_back(lower + offset);
+			}
+			for (uint64_t i = 0; i < size; i++)
+			{
+				std::swap(res[i], res[i + _random::uniform_inclusive(generator, max_offset - i)]);
+			}
+			res.resize(size);
+			return res;
+		}
+
+		// sparse: floyd's algorithm draws exactly 'size' numbers and only remembers the ones taken
+		std::unordered_set<uint64_t> taken;
+		taken.reserve(size);
+		for (uint64_t limit = max_offset - size + 1; limit <= max_offset && res.size() < size; limit++)
+		{
+			uint64_t offset = _random::uniform_inclusive(generator, limit);
+			if (!taken.insert(offset).second)
+			{
+				offset = limit;
+				taken.insert(offset);
+			}
+			res.emplace_back(lower + offset);
+		}
+		// floyd's picks are not in random order, a shuffle restores it
+		for (uint64_t i = res.size(); i > 1; i--)
+		{
+			std::swap(res[i - 1], res[_random::uniform_inclusive(generator, i - 1)]);
+		}
+		return res;
+	}
+
+	/*
+	* bulk random number generation
+	*
+	* the values only depend on 'seed' and their position 'first_index + i' in the sequence: filling disjoint parts of
+	* a range on different threads, each with its own subspan and first_index, gives exactly the numbers of one
+	* serial call with the same seed. the overloads without a seed take one from thread_generator().
+	*/
+
+	/*
+	* @param out - receives random numbers equal to or between 'lower' and 'upper'
+	* @throws invalid_argument if upper < lower
+	*/
+	static inline void fill_random(std::span<uint64_t> out, uint64_t lower, uint64_t upper, uint64_t seed, uint64_t first_index = 0)
+	{
+		if (upper < lower)
+		{
+			throw std::invalid_argument("upper range cannot be smaller than lower range");
+		}
+		const uint64_t bound = upper - lower + 1;
+		const uint64_t threshold = bound ? (0 - bound) % bound : 0;
+		_random::random_batches(seed, first_index, out.size(), [&](size_t i, const uint64_t* values, size_t n)
+		{
+			uint64_t* dest = out.data() + i;
+			if (!bound) // the full 64-bit range
+			{
+				std::copy(values, values + n, dest);
+				return;
+			}
+			for (size_t k = 0; k < n; k++)
+			{
+				// lemire's method, a rejected value is redrawn from its own counter so the sequence stays reproducible
+				uint64_t random = values[k];
+				for (uint32_t retry = 1; random * bound < threshold; retry++)
+				{
+					random = _random::redraw(seed, first_index + i + k, retry);
+				}
+				dest[k] = lower + _random::mul_hi(random, bound);
+			}
+		});
+	}
+
+	static inline void fill_random(std::span<uint64_t> out, uint64_t lower, uint64_t upper)
+	{
+		fill_random(out, lower, upper, thread_generator()());
+	}
+
+	/*
+	* @param out - receives uniformly distributed numbers in ['lower', 'upper')
+	*/
+	template <typename Type>
+		requires std::floating_point<Type>
+	static inline void fill_random(std::span<Type> out, Type lower, Type upper, uint64_t seed, uint64_t first_index = 0)
+	{
+		const Type scale = upper - lower;
+		const Type largest = std::nextafter(upper, lower); // rounding must not reach 'upper'
+		if constexpr (sizeof(Type) <= sizeof(uint32_t))
+		{
+			// 24 random bits are all a float can hold, so every 64-bit value makes two floats
+			const uint64_t end_index = first_index + out.size();
+			_random::random_batches(seed, first_index / 2, (end_index + 1) / 2 - first_index / 2, [&](size_t i, const uint64_t* values, size_t n)
+			{
+				for (size_t k = 0; k < n; k++)
+				{
+					const uint64_t index = (first_index / 2 + i + k) * 2;
+					const uint32_t halves[2] = { static_cast<uint32_t>(values[k]), static_cast<uint32_t>(values[k] >> 32) };
+					for (size_t half = 0; half < 2; half++)
+					{
+						if (index + half >= first_index && index + half < end_index)
+						{
+							const Type unit = static_cast<Type>(halves[half] >> 8) * static_cast<Type>(0x1.0p-24);
+							out[static_cast<size_t>(index + half - first_index)] = std::min(lower + scale * unit, largest);
+						}
+					}
+				}
+			});
+		}
+		else
+		{
+			_random::random_batches(seed, first_index, out.size(), [&](size_t i, const uint64_t* values, size_t n)
+			{
+				Type* dest = out.data() + i;
+				for (size_t k = 0; k < n; k++)
+				{
+					dest[k] = std::min(lower + scale * static_cast<Type>(_random::to_unit(values[k])), largest);
+				}
+			});
+		}
+	}
+
+	template <typename Type>
+		requires std::floating_point<Type>
+	static inline void fill_random(std::span<Type> out, Type lower, Type upper)
+	{
+		fill_random(out, lower, upper, thread_generator()());
+	}
+
+	/*
+	* @param out - receives normally distributed numbers, generated pairwise from consecutive values with the box-muller transform
+	*/
+	template <typename Type>
+		requires std::floating_point<Type>
+	static inline void fill_random_normal(std::span<Type> out, Type mean, Type stddev, uint64_t seed, uint64_t first_index = 0)
+	{
+		const uint64_t end_index = first_index + out.size();
+		const uint64_t first_pair = first_index / 2 * 2;
+		_random::random_batches(seed, first_pair, (end_index + 1) / 2 * 2 - first_pair, [&](size_t i, const uint64_t* values, size_t n)
+		{
+			// batches start on even values, so pairs are never split
+			for (size_t k = 0; k + 1 < n; k += 2)
+			{
+				const uint64_t index = first_pair + i + k;
+				// u1 in (0, 1] keeps the logarithm finite
+				const double radius = std::sqrt(-2.0 * std::log(1.0 - _random::to_unit(values[k])));
+				const double angle = 2.0 * std::numbers::pi * _random::to_unit(values[k + 1]);
+				if (index >= first_index)
+				{
+					out[static_cast<size_t>(index - first_index)] = mean + stddev * static_cast<Type>(radius * std::cos(angle));
+				}
+				if (index + 1 < end_index)
+				{
+					out[static_cast<size_t>(index + 1 - first_index)] = mean + stddev * static_cast<Type>(radius * std::sin(angle));
+				}
+			}
+		});
+	}
+
+	template <typename Type>
+		requires std::floating_point<Type>
+	static inline void fill_random_normal(std::span<Type> out, Type mean, Type stddev)
+	{
+		fill_random_normal(out, mean, stddev, thread_generator()());
+	}
+
+	namespace _prime
+	{
+		static constexpr uint32_t small_primes[] = { 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41, 43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97 };
+
+		/*
+		* arithmetic modulo an odd 'modulus' on numbers in montgomery form (x * 2^64 mod modulus),
+		* which replaces every division by two multiplications
+		*/
+		struct montgomery
+		{
+			uint64_t modulus;
+			uint64_t inverse; // modulus^-1 mod 2^64
+			uint64_t one;     // 2^64 mod modulus
+			uint64_t r2;      // 2^128 mod modulus
+
+			explicit montgomery(uint64_t odd_modulus)
+				: modulus(odd_modulus)
+			{
+				// newton iteration, every step doubles the number of correct low bits
+				inverse = modulus;
+				for (int i = 0; i < 5; i++)
+				{
+					inverse *= 2 - modulus * inverse;
+				}
+				one = (0 - modulus) % modulus;
+				r2 = one;
+				for (int i = 0; i < 64; i++)
+				{
+					r2 = r2 >= modulus - r2 ? r2 - (modulus - r2) : r2 + r2;
+				}
+			}
+
+			// a * b * 2^-64 mod modulus
+			uint64_t multiply(uint64_t a, uint64_t b) const
+			{
+				const uint64_t low = a * b;
+				const uint64_t high = _random::mul_hi(a, b);
+				const uint64_t correction = _random::mul_hi(low * inverse, modulus);
+				return high >= correction ? high - correction : high - correction + modulus;
+			}
+
+			uint64_t to_montgomery(uint64_t value) const
+			{
+				return multiply(value % modulus, r2);
+			}
+
+			uint64_t power(uint64_t base, uint64_t exponent) const
+			{
+				uint64_t res = one;
+				while (exponent)
+				{
+					if (exponent & 1)
+					{
+						res = multiply(res, base);
+					}
+					base = multiply(base, base);
+					exponent >>= 1;
+				}
+				return res;
+			}
+		};
+
+		/*
+		* deterministic miller-rabin for odd numbers above the small primes. the bases (Jim Sinclair)
+		* identify every composite below 2^64.
+		*/
+		static inline bool miller_rabin(uint64_t number)
+		{
+			static constexpr uint64_t bases[] = { 2, 325, 9375, 28178, 450775, 9780504, 1795265022 };
+			const montgomery field(number);
+			const uint64_t minus_one = number - field.one;
+			uint64_t odd_part = number - 1;
+			int twos = 0;
+			while (!(odd_part & 1))
+			{
+				odd_part >>= 1;
+				twos++;
+			}
+			for (uint64_t base : bases)
+			{
+				const uint64_t witness = field.to_montgomery(base);
+				if (!witness)
+				{
+					continue; // base is a multiple of 'number'
+				}
+				uint64_t x = field.power(witness, odd_part);
+				if (x == field.one || x == minus_one)
+				{
+					continue;
+				}
+				bool probable = false;
+				for (int i = 1; i < twos && !probable; i++)
+				{
+					x = field.multiply(x, x);
+					probable = x == minus_one;
+				}
+				if (!probable)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		static inline uint64_t isqrt(uint64_t number)
+		{
+			uint64_t root = static_cast<uint64_t>(std::sqrt(static_cast<double>(number)));
+			while (root > 0xFFFFFFFFULL || root * root > number)
+			{
+				root--;
+			}
+			while (root < 0xFFFFFFFFULL && (root + 1) * (root + 1) <= number)
+			{
+				root++;
+			}
+			return root;
+		}
+
+		// odd primes up to 'limit' with a segmented sieve of eratosthenes over the odd numbers. besides the
+		// result only one segment and the primes up to sqrt(limit) are held, instead of one byte per odd number
+		static inline std::vector<uint32_t> odd_primes_up_to(uint32_t limit)
+		{
+			std::vector<uint32_t> res;
+			if (limit < 3)
+			{
+				return res;
+			}
+			// the sieving primes up to sqrt(limit) < 2^16 with a plain sieve, index i is 2i + 3
+			const uint64_t root = isqrt(limit);
+			std::vector<uint8_t> small_composite(root < 3 ? 0 : static_cast<size_t>((root - 1) / 2), 0);
+			std::vector<uint64_t> sieving_primes;
+			for (size_t i = 0; i < small_composite.size(); i++)
+			{
+				if (small_composite[i])
+				{
+					continue;
+				}
+				const uint64_t prime = 2 * i + 3;
+				sieving_primes.emplace_back(prime);
+				for (uint64_t multiple = (prime * prime - 3) / 2; multiple < small_composite.size(); multiple += prime)
+				{
+					small_composite[static_cast<size_t>(multiple)] = 1;
+				}
+			}
+			// index of the next odd multiple of every sieving prime, carried from segment to segment
+			std::vector<uint64_t> next_multiple(sieving_primes.size());
+			for (size_t k = 0; k < sieving_primes.size(); k++)
+			{
+				next_multiple[k] = (sieving_primes[k] * sieving_primes[k] - 3) / 2;
+			}
+			const uint64_t odd_count = (static_cast<uint64_t>(limit) - 1) / 2;
+			const uint64_t segment_length = 32 * 1024;
+			std::vector<uint8_t> composite(static_cast<size_t>(segment_length));
+			for (uint64_t first = 0; first < odd_count; first += segment_length)
+			{
+				const uint64_t last = std::min(odd_count, first + segment_length);
+				std::fill(composite.begin(), composite.end(), uint8_t(0));
+				for (size_t k = 0; k < sieving_primes.size(); k++)
+				{
+					uint64_t multiple = next_multiple[k];
+					for (; multiple < last; multiple += sieving_primes[k])
+					{
+						composite[static_cast<size_t>(multiple - first)] = 1;
+					}
+					next_multiple[k] = multiple;
+				}
+				for (uint64_t i = first; i < last; i++)
+				{
+					if (!composite[static_cast<size_t>(i - first)])
+					{
+						res.emplace_back(static_cast<uint32_t>(2 * i + 3));
+					}
+				}
+			}
+			return res;
+		}
+	}
+
+	/*
+	* tests if a number is prime. 64-bit numbers go through a few trial divisions and deterministic
+	* miller-rabin with montgomery multiplication, wider types fall back to trial division.
+	* @param _num unsigned integer type to test
+	* @tparam numtype any type that satisfies std::unsigned_integral
+	* @returns true if _num is prime, otherwise false
+	*/
+	template<typename numtype>
+		requires std::unsigned_integral<numtype>
+	static inline bool is_prime(const numtype& _num)
+	{
+		if (_num < 2U)
+		{
+			return false;
+		}
+		if (!(_num % 2U))
+		{
+			return _num == 2U;
+		}
+		if constexpr (sizeof(numtype) <= sizeof(uint64_t))
+		{
+			const uint64_t number = static_cast<uint64_t>(_num);
+			for (uint32_t prime : _prime::small_primes)
+			{
+				if (number % prime == 0)
+				{
+					return number == prime;
+				}
+			}
+			if (number < 101 * 101) // no factor below 101 left
+			{
+				return true;
+			}
+			return _prime::miller_rabin(number);
+		}
+		else
+		{
+			for (numtype divisor = 3U; divisor <= _num / divisor; divisor += 2U)
+			{
+				if (!(_num % divisor)) { return false; }
+			}
+			return true;
+		}
+	}
+
+	/*
+	* all primes equal to or between 'lower' and 'upper' in ascending order.
+	* wide ranges run a segmented sieve of eratosthenes, each segment small enough for the l1 cache and the
+	* segments spread over 'pool'. ranges narrower than sqrt(upper), where sieving the base primes would
+	* dominate, test every odd candidate with is_prime instead.
+	* @param segment_bytes - sieve segment size, every byte stands for one odd number
+	*/
+	static inline std::vector<uint64_t> primes_in_range(uint64_t lower, uint64_t upper, thread_pool& pool = thread_pool::shared(), size_t segment_bytes = 32 * 1024)
+	{
+		std::vector<uint64_t> res;
+		if (upper < lower || upper < 2)
+		{
+			return res;
+		}
+		if (lower <= 2)
+		{
+			res.emplace_back(2);
+		}
+		const uint64_t first_odd = std::max<uint64_t>(lower, 3) | 1;
+		if (first_odd > upper)
+		{
+			return res;
+		}
+		const uint64_t odd_count = (upper - first_odd) / 2 + 1;
+		const uint64_t root = _prime::isqrt(upper);
+		const uint64_t segment_length = std::max<size_t>(segment_bytes, 64);
+		const size_t segment_count = static_cast<size_t>((odd_count + segment_length - 1) / segment_length);
+		std::vector<std::vector<uint64_t>> found(segment_count);
+
+		if (upper - lower < root)
+		{
+			pool.parallel_for(segment_count, [&](size_t segment)
+			{
+				const uint64_t first = segment * segment_length;
+				const uint64_t last = std::min(odd_count, first + segment_length);
+				for (uint64_t i = first; i < last; i++)
+				{
+					if (is_prime(first_odd + 2 * i))
+					{
+						found[segment].emplace_back(first_odd + 2 * i);
+					}
+				}
+			});
+		}
+		else
 		{
-			numbers.emplace_back(i);
+			const std::vector<uint32_t> base_primes = _prime::odd_primes_up_to(static_cast<uint32_t>(root));
+			pool.parallel_for(segment_count, [&](size_t segment)
+			{
+				const uint64_t first = segment * segment_length;
+				const size_t length = static_cast<size_t>(std::min(odd_count - first, segment_length));
+				const uint64_t segment_lower = first_odd + 2 * first;
+				const uint64_t segment_upper = segment_lower + 2 * (length - 1);
+				std::vector<uint8_t> composite(length, 0); // index i is segment_lower + 2i
+				for (uint32_t prime : base_primes)
+				{
+					const uint64_t square = static_cast<uint64_t>(prime) * prime;
+					if (square > segment_upper)
+					{
+						break;
+					}
+					// distance to the first odd multiple that is not below prime^2, always even
+					uint64_t offset;
+					if (square >= segment_lower)
+					{
+						offset = square - segment_lower;
+					}
+					else
+					{
+						const uint64_t remainder = segment_lower % prime;
+						offset = remainder ? prime - remainder : 0;
+						if (offset & 1)
+						{
+							offset += prime;
+						}
+					}
+					for (uint64_t i = offset / 2; i < length; i += prime)
+					{
+						composite[static_cast<size_t>(i)] = 1;
+					}
+				}
+				for (size_t i = 0; i < length; i++)
+				{
+					if (!composite[i])
+					{
+						found[segment].emplace_back(segment_lower + 2 * i);
+					}
+				}
+			});
 		}
-		
-		std::random_device random_device;
-		std::mt19937 random_number_generator(random_device());
 
-		for (uint64_t i = 0; i < size; i++)
+		for (const std::vector<uint64_t>& segment_primes : found)
 		{
-			std::uniform_int_distribution<std::mt19937::result_type> distribution(0, numbers.size() - 1);
-			std::vector<uint64_t>::iterator next_num = numbers.begin() + static_cast<uint64_t>(distribution(random_number_generator));
-			res.emplace_back(*next_num);
-			numbers.erase(next_num);
+			res.insert(res.end(), segment_primes.begin(), segment_primes.end());
 		}
-		
 		return res;
 	}
 }
@@ -9,15 +9,838 @@
 #define UTILITYLIB_REGEX_HPP
 ////////////////////////////////////////
 #include <string>
+#include <string_view>
 #include <regex>
+#include <bitset>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
 #include "stringmanip.hpp"
 ////////////////////////////////////////
 namespace util
 {
+	/*
+	* linear-time matcher for the common subset of ECMAScript patterns: literals, '.', character classes,
+	* \d \w \s (and negations), escapes, non-capturing groups '(?:...)', alternation and greedy or lazy
+	* quantifiers (* + ? {n} {n,} {n,m}). patterns are compiled to a Thompson NFA and run by a pike VM,
+	* so the time is linear in the input, and the leftmost match is the same one std::regex reports.
+	* capture groups, anchors, word boundaries, backreferences, lookarounds and quantified subexpressions
+	* that can match the empty string are left to std::regex.
+	*/
+	namespace _regex
+	{
+		using byte_set = std::bitset<256>;
+
+		enum class opcode : uint8_t { set, split, jump, match };
+
+		struct instruction
+		{
+			opcode   code = opcode::match;
+			uint32_t x = 0; // set: index into the program's sets, split/jump: target (split: preferred one)
+			uint32_t y = 0; // split: other target
+		};
+
+		struct program
+		{
+			std::vector<instruction> code;
+			std::vector<byte_set>    sets;
+			byte_set first;            // bytes a non-empty match can start with
+			bool can_be_empty = false; // an empty match is possible, 'first' can then not be used to skip ahead
+		};
+
+		struct ast
+		{
+			enum class kind : uint8_t { set, concat, alternate, repeat };
+			kind     type = kind::concat;
+			uint32_t set = 0;
+			uint32_t min = 0;
+			uint32_t max = 0;
+			bool     greedy = true;
+			std::vector<ast> children;
+		};
+
+		static constexpr uint32_t repeat_infinite = UINT32_MAX;
+		static constexpr uint32_t max_repeat = 1000;
+		static constexpr size_t   max_program_size = 1 << 16;
+
+		/*
+		* @returns bytes that std::regex matches with the single-character pattern 'pattern',
+		* so '.', \d, \w and \s behave exactly like in the standard library in use
+		*/
+		static inline byte_set std_byte_set(const char* pattern)
+		{
+			byte_set res;
+			std::regex regex(pattern);
+			for (size_t i = 0; i < 256; i++)
+			{
+				char c = static_cast<char>(i);
+				if (std::regex_match(&c, &c + 1, regex))
+				{
+					res.set(i);
+				}
+			}
+			return res;
+		}
+
+		static inline const byte_set& class_set(char name)
+		{
+			static const byte_set dot = std_byte_set(".");
+			static const byte_set digit = std_byte_set("\\d");
+			static const byte_set word = std_byte_set("\\w");
+			static const byte_set space = std_byte_set("\\s");
+			switch (name)
+			{
+			case 'd': return digit;
+			case 'w': return word;
+			case 's': return space;
+			default: return dot;
+			}
+		}
+
+		static inline int hex_value(char c)
+		{
+			if (c >= '0' && c <= '9') { return c - '0'; }
+			if (c >= 'a' && c <= 'f') { return c - 'a' + 10; }
+			if (c >= 'A' && c <= 'F') { return c - 'A' + 10; }
+			return -1;
+		}
+
+		/*
+		* recursive descent parser for the supported subset, fails on everything else
+		*/
+		class parser
+		{
+		public:
+			parser(std::string_view pattern, std::vector<byte_set>& sets) : pattern(pattern), sets(sets) {}
+
+			bool parse(ast& res)
+			{
+				return parse_alternate(res, 0) && pos == pattern.size();
+			}
+
+		private:
+			std::string_view pattern;
+			std::vector<byte_set>& sets;
+			size_t pos = 0;
+
+			bool more() const { return pos < pattern.size(); }
+			char peek() const { return pattern[pos]; }
+
+			ast make_set(const byte_set& set)
+			{
+				ast res;
+				res.type = ast::kind::set;
+				res.set = static_cast<uint32_t>(sets.size());
+				sets.emplace_back(set);
+				return res;
+			}
+
+			// node can match the empty string
+			static bool nullable(const ast& node)
+			{
+				switch (node.type)
+				{
+				case ast::kind::set: return false;
+				case ast::kind::repeat: return !node.min || nullable(node.children.front());
+				case ast::kind::alternate: return std::any_of(node.children.begin(), node.children.end(), nullable);
+				default: return std::all_of(node.children.begin(), node.children.end(), nullable);
+				}
+			}
+
+			bool parse_alternate(ast& res, size_t depth)
+			{
+				if (depth > 256)
+				{
+					return false;
+				}
+				ast first;
+				if (!parse_concat(first, depth))
+				{
+					return false;
+				}
+				if (!more() || peek() != '|')
+				{
+					res = std::move(first);
+					return true;
+				}
+				res.type = ast::kind::alternate;
+				res.children.emplace_back(std::move(first));
+				while (more() && peek() == '|')
+				{
+					pos++;
+					ast next;
+					if (!parse_concat(next, depth))
+					{
+						return false;
+					}
+					res.children.emplace_back(std::move(next));
+				}
+				return true;
+			}
+
+			bool parse_concat(ast& res, size_t depth)
+			{
+				res.type = ast::kind::concat;
+				while (more() && peek() != '|' && peek() != ')')
+				{
+					ast atom;
+					if (!parse_repeat(atom, depth))
+					{
+						return false;
+					}
+					res.children.emplace_back(std::move(atom));
+				}
+				return true;
+			}
+
+			bool parse_repeat(ast& res, size_t depth)
+			{
+				ast atom;
+				if (!parse_atom(atom, depth))
+				{
+					return false;
+				}
+				if (!more() || (peek() != '*' && peek() != '+' && peek() != '?' && peek() != '{'))
+				{
+					res = std::move(atom);
+					return true;
+				}
+				uint32_t min = 0;
+				uint32_t max = repeat_infinite;
+				switch (pattern[pos++])
+				{
+				case '*': break;
+				case '+': min = 1; break;
+				case '?': max = 1; break;
+				default:
+					if (!parse_braces(min, max))
+					{
+						return false;
+					}
+				}
+				bool greedy = true;
+				if (more() && peek() == '?')
+				{
+					greedy = false;
+					pos++;
+				}
+				if (more() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{'))
+				{
+					return false; // stacked quantifiers are an error, std::regex reports it
+				}
+				if (max > min && nullable(atom))
+				{
+					return false; // ECMAScript rejects empty iterations, the VM can not express that
+				}
+				res.type = ast::kind::repeat;
+				res.min = min;
+				res.max = max;
+				res.greedy = greedy;
+				res.children.emplace_back(std::move(atom));
+				return true;
+			}
+
+			bool parse_number(uint32_t& res)
+			{
+				size_t start = pos;
+				res = 0;
+				while (more() && peek() >= '0' && peek() <= '9')
+				{
+					res = res * 10 + static_cast<uint32_t>(pattern[pos++] - '0');
+					if (res > max_repeat)
+					{
+						return false;
+					}
+				}
+				return pos != start;
+			}
+
+			// "{n}", "{n,}" or "{n,m}", the '{' is already consumed
+			bool parse_braces(uint32_t& min, uint32_t& max)
+			{
+				if (!parse_number(min))
+				{
+					return false;
+				}
+				max = min;
+				if (more() && peek() == ',')
+				{
+					pos++;
+					max = repeat_infinite;
+					if (more() && peek() != '}' && !parse_number(max))
+					{
+						return false;
+					}
+				}
+				if (!more() || pattern[pos++] != '}')
+				{
+					return false;
+				}
+				return max >= min;
+			}
+
+			bool parse_atom(ast& res, size_t depth)
+			{
+				char c = pattern[pos++];
+				byte_set set;
+				switch (c)
+				{
+				case '(':
+					if (pattern.substr(pos, 2) != "?:")
+					{
+						return false; // capture groups and lookarounds
+					}
+					pos += 2;
+					if (!parse_alternate(res, depth + 1) || !more() || pattern[pos++] != ')')
+					{
+						return false;
+					}
+					return true;
+				case '[':
+					if (!parse_class(set))
+					{
+						return false;
+					}
+					break;
+				case '.':
+					set = class_set('.');
+					break;
+				case '\\':
+					if (!parse_escape(set))
+					{
+						return false;
+					}
+					break;
+				case '^': case '$': case '*': case '+': case '?': case '{': case '}': case ']': case ')':
+					return false;
+				default:
+					set.set(static_cast<unsigned char>(c));
+				}
+				res = make_set(set);
+				return true;
+			}
+
+			// the '\' is already consumed
+			bool parse_escape(byte_set& set)
+			{
+				if (!more())
+				{
+					return false;
+				}
+				char c = pattern[pos++];
+				switch (c)
+				{
+				case 'd': case 'w': case 's': set = class_set(c); return true;
+				case 'D': case 'W': case 'S': set = ~class_set(static_cast<char>(c - 'A' + 'a')); return true;
+				case 't': set.set('\t'); return true;
+				case 'n': set.set('\n'); return true;
+				case 'r': set.set('\r'); return true;
+				case 'f': set.set('\f'); return true;
+				case 'v': set.set('\v'); return true;
+				case 'x':
+				{
+					if (pos + 2 > pattern.size() || hex_value(pattern[pos]) < 0 || hex_value(pattern[pos + 1]) < 0)
+					{
+						return false;
+					}
+					set.set(static_cast<size_t>(hex_value(pattern[pos]) * 16 + hex_value(pattern[pos + 1])));
+					pos += 2;
+					return true;
+				}
+				default:
+					if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || static_cast<unsigned char>(c) >= 128)
+					{
+						return false; // backreferences, \b, \B, \c, \u, ...
+					}
+					set.set(static_cast<unsigned char>(c));
+					return true;
+				}
+			}
+
+			// a single class member, 'value' is set if it is a single ASCII character that can start or end a range
+			bool parse_class_atom(byte_set& set, int& value)
+			{
+				value = -1;
+				char c = pattern[pos++];
+				if (c == '\\')
+				{
+					if (!parse_escape(set))
+					{
+						return false;
+					}
+					if (set.count() == 1)
+					{
+						for (size_t i = 0; i < 128; i++)
+						{
+							if (set.test(i)) { value = static_cast<int>(i); }
+						}
+					}
+					return true;
+				}
+				set.set(static_cast<unsigned char>(c));
+				if (static_cast<unsigned char>(c) < 128)
+				{
+					value = c;
+				}
+				return true;
+			}
+
+			// the '[' is already consumed
+			bool parse_class(byte_set& set)
+			{
+				bool negate = more() && peek() == '^';
+				if (negate)
+				{
+					pos++;
+				}
+				if (!more() || peek() == ']')
+				{
+					return false; // '[]' and '[^]' are left to std::regex
+				}
+				while (true)
+				{
+					if (!more())
+					{
+						return false;
+					}
+					if (peek() == ']')
+					{
+						pos++;
+						break;
+					}
+					if (peek() == '[' && pos + 1 < pattern.size() && (pattern[pos + 1] == ':' || pattern[pos + 1] == '=' || pattern[pos + 1] == '.'))
+					{
+						return false; // [:alpha:] and friends
+					}
+					byte_set item;
+					int low = 0;
+					if (!parse_class_atom(item, low))
+					{
+						return false;
+					}
+					if (pos + 1 < pattern.size() && peek() == '-' && pattern[pos + 1] != ']')
+					{
+						pos++;
+						byte_set upper;
+						int high = 0;
+						if (low < 0 || !parse_class_atom(upper, high) || high < low)
+						{
+							return false;
+						}
+						for (int i = low; i <= high; i++)
+						{
+							item.set(static_cast<size_t>(i));
+						}
+					}
+					set |= item;
+				}
+				if (negate)
+				{
+					set.flip();
+				}
+				return true;
+			}
+		};
+
+		/*
+		* Thompson construction of the instructions for 'node'
+		*/
+		static inline bool emit(const ast& node, std::vector<instruction>& code)
+		{
+			if (code.size() > max_program_size)
+			{
+				return false;
+			}
+			switch (node.type)
+			{
+			case ast::kind::set:
+				code.emplace_back(instruction{ opcode::set, node.set, 0 });
+				return true;
+			case ast::kind::concat:
+				for (const ast& child : node.children)
+				{
+					if (!emit(child, code)) { return false; }
+				}
+				return true;
+			case ast::kind::alternate:
+			{
+				std::vector<size_t> jumps;
+				for (size_t i = 0; i < node.children.size(); i++)
+				{
+					if (i + 1 == node.children.size())
+					{
+						if (!emit(node.children[i], code)) { return false; }
+						break;
+					}
+					size_t split = code.size();
+					code.emplace_back(instruction{ opcode::split, static_cast<uint32_t>(split + 1), 0 });
+					if (!emit(node.children[i], code)) { return false; }
+					jumps.emplace_back(code.size());
+					code.emplace_back(instruction{ opcode::jump, 0, 0 });
+					code[split].y = static_cast<uint32_t>(code.size());
+				}
+				for (size_t jump : jumps)
+				{
+					code[jump].x = static_cast<uint32_t>(code.size());
+				}
+				return true;
+			}
+			case ast::kind::repeat:
+			{
+				const ast& child = node.children.front();
+				for (uint32_t i = 0; i < node.min; i++)
+				{
+					if (!emit(child, code)) { return false; }
+				}
+				if (node.max == repeat_infinite)
+				{
+					// loop: split body/out, body, jump back
+					size_t split = code.size();
+					code.emplace_back(instruction{ opcode::split, 0, 0 });
+					if (!emit(child, code)) { return false; }
+					code.emplace_back(instruction{ opcode::jump, static_cast<uint32_t>(split), 0 });
+					uint32_t body = static_cast<uint32_t>(split + 1);
+					uint32_t out = static_cast<uint32_t>(code.size());
+					code[split].x = node.greedy ? body : out;
+					code[split].y = node.greedy ? out : body;
+					return true;
+				}
+				// nested optionals, every one of them leaves to the end
+				std::vector<size_t> splits;
+				for (uint32_t i = node.min; i < node.max; i++)
+				{
+					splits.emplace_back(code.size());
+					code.emplace_back(instruction{ opcode::split, 0, 0 });
+					if (!emit(child, code)) { return false; }
+				}
+				uint32_t out = static_cast<uint32_t>(code.size());
+				for (size_t split : splits)
+				{
+					code[split].x = node.greedy ? static_cast<uint32_t>(split + 1) : out;
+					code[split].y = node.greedy ? out : static_cast<uint32_t>(split + 1);
+				}
+				return true;
+			}
+			}
+			return false;
+		}
+
+		/*
+		* @returns if 'pattern' is part of the supported subset, then 'res' holds its program
+		*/
+		static inline bool compile(std::string_view pattern, program& res)
+		{
+			ast root;
+			parser parse(pattern, res.sets);
+			if (!parse.parse(root) || !emit(root, res.code) || res.code.size() > max_program_size)
+			{
+				return false;
+			}
+			res.code.emplace_back(instruction{ opcode::match, 0, 0 });
+
+			// bytes a match can start with, from the epsilon closure of the entry
+			std::vector<bool> seen(res.code.size(), false);
+			std::vector<uint32_t> stack{ 0 };
+			while (!stack.empty())
+			{
+				uint32_t pc = stack.back();
+				stack.pop_back();
+				if (seen[pc])
+				{
+					continue;
+				}
+				seen[pc] = true;
+				const instruction& inst = res.code[pc];
+				switch (inst.code)
+				{
+				case opcode::set: res.first |= res.sets[inst.x]; break;
+				case opcode::match: res.can_be_empty = true; break;
+				case opcode::jump: stack.emplace_back(inst.x); break;
+				case opcode::split: stack.emplace_back(inst.y); stack.emplace_back(inst.x); break;
+				}
+			}
+			return true;
+		}
+
+		/*
+		* pike VM over a program, keeps its thread lists between searches
+		*/
+		class matcher
+		{
+		public:
+			matcher(const program& prog) : prog(prog), marks(prog.code.size(), 0)
+			{
+				if (prog.first.count() == 1)
+				{
+					for (size_t i = 0; i < 256; i++)
+					{
+						if (prog.first.test(i)) { first_byte = static_cast<int>(i); }
+					}
+				}
+			}
+
+			/*
+			* leftmost match starting at or behind 'from', priorities follow the backtracking order of std::regex
+			*/
+			bool search(std::string_view input, size_t from, size_t& index, size_t& length)
+			{
+				bool matched = false;
+				current.clear();
+				generation++;
+				for (size_t pos = from; ; pos++)
+				{
+					if (!matched)
+					{
+						if (current.empty() && !prog.can_be_empty)
+						{
+							pos = skip(input, pos);
+							if (pos >= input.size())
+							{
+								break;
+							}
+						}
+						add(current, 0, pos);
+					}
+					if (current.empty())
+					{
+						break;
+					}
+					generation++;
+					next.clear();
+					int byte = pos < input.size() ? static_cast<unsigned char>(input[pos]) : -1;
+					for (const thread& t : current)
+					{
+						const instruction& inst = prog.code[t.pc];
+						if (inst.code == opcode::match)
+						{
+							matched = true;
+							index = t.start;
+							length = pos - t.start;
+							break; // threads behind this one have a lower priority
+						}
+						if (byte >= 0 && prog.sets[inst.x].test(static_cast<size_t>(byte)))
+						{
+							add(next, t.pc + 1, t.start);
+						}
+					}
+					std::swap(current, next);
+					if (pos >= input.size())
+					{
+						break;
+					}
+				}
+				return matched;
+			}
+
+		private:
+			struct thread
+			{
+				uint32_t pc;
+				size_t   start;
+			};
+
+			const program& prog;
+			std::vector<uint32_t> marks; // generation in which an instruction was last added
+			uint32_t generation = 0;
+			std::vector<thread> current;
+			std::vector<thread> next;
+			std::vector<thread> stack;
+			int first_byte = -1;
+
+			// next position a match can start at
+			size_t skip(std::string_view input, size_t pos) const
+			{
+				if (pos >= input.size())
+				{
+					return input.size();
+				}
+				if (first_byte >= 0)
+				{
+					const void* hit = std::memchr(input.data() + pos, first_byte, input.size() - pos);
+					return hit ? static_cast<size_t>(static_cast<const char*>(hit) - input.data()) : input.size();
+				}
+				while (pos < input.size() && !prog.first.test(static_cast<unsigned char>(input[pos])))
+				{
+					pos++;
+				}
+				return pos;
+			}
+
+			// adds the epsilon closure of 'pc' in priority order
+			void add(std::vector<thread>& list, uint32_t pc, size_t start)
+			{
+				stack.emplace_back(thread{ pc, start });
+				while (!stack.empty())
+				{
+					thread t = stack.back();
+					stack.pop_back();
+					if (marks[t.pc] == generation)
+					{
+						continue;
+					}
+					marks[t.pc] = generation;
+					const instruction& inst = prog.code[t.pc];
+					switch (inst.code)
+					{
+					case opcode::jump:
+						stack.emplace_back(thread{ inst.x, t.start });
+						break;
+					case opcode::split:
+						stack.emplace_back(thread{ inst.y, t.start });
+						stack.emplace_back(thread{ inst.x, t.start });
+						break;
+					default:
+						list.emplace_back(t);
+					}
+				}
+			}
+		};
+	}
+
+	/*
+	* match as a view into the searched input
+	*/
+	struct regex_match_view
+	{
+		std::string_view content;
+		size_t length = 0;
+		size_t index  = 0;
+	};
+
+	/*
+	* a pattern compiled once, for the linear matcher if it is part of its subset, otherwise for std::regex only
+	*/
+	class compiled_regex
+	{
+	public:
+		explicit compiled_regex(const std::string& pattern) : pattern_str(pattern), regex(pattern)
+		{
+			is_linear = _regex::compile(pattern, prog);
+			if (!is_linear)
+			{
+				prog = _regex::program();
+			}
+		}
+
+		const std::string& pattern() const { return pattern_str; }
+		const std::regex& std_regex() const { return regex; }
+		/*
+		* @returns if searches run on the linear matcher instead of std::regex
+		*/
+		bool linear() const { return is_linear; }
+
+		/*
+		* leftmost match in 'input' that starts at or behind 'from'
+		*/
+		bool search(std::string_view input, size_t from, regex_match_view& match) const
+		{
+			if (is_linear)
+			{
+				_regex::matcher vm(prog);
+				return search(vm, input, from, match);
+			}
+			return search_std(input, from, match);
+		}
+
+		/*
+		* every non-overlapping match in 'input', empty matches advance the search by one character
+		*/
+		std::vector<regex_match_view> find_all(std::string_view input) const
+		{
+			std::vector<regex_match_view> res;
+			regex_match_view match;
+			std::unique_ptr<_regex::matcher> vm = is_linear ? std::make_unique<_regex::matcher>(prog) : nullptr;
+			size_t from = 0;
+			while (from <= input.size() && (vm ? search(*vm, input, from, match) : search_std(input, from, match)))
+			{
+				res.emplace_back(match);
+				from = match.index + (match.length ? match.length : 1);
+			}
+			return res;
+		}
+
+	private:
+		std::string pattern_str;
+		std::regex regex;
+		_regex::program prog;
+		bool is_linear = false;
+
+		bool search(_regex::matcher& vm, std::string_view input, size_t from, regex_match_view& match) const
+		{
+			if (!vm.search(input, from, match.index, match.length))
+			{
+				return false;
+			}
+			match.content = input.substr(match.index, match.length);
+			return true;
+		}
+
+		bool search_std(std::string_view input, size_t from, regex_match_view& match) const
+		{
+			std::cmatch matches;
+			const char* begin = input.data() + from;
+			std::regex_constants::match_flag_type flags = from ? std::regex_constants::match_prev_avail : std::regex_constants::match_default;
+			if (!std::regex_search(begin, input.data() + input.size(), matches, regex, flags))
+			{
+				return false;
+			}
+			match.index = static_cast<size_t>(matches[0].first - input.data());
+			match.length = static_cast<size_t>(matches[0].length());
+			match.content = input.substr(match.index, match.length);
+			return true;
+		}
+	};
+
+	namespace _regex
+	{
+		struct cache
+		{
+			std::mutex mutex;
+			std::unordered_map<std::string, std::shared_ptr<const compiled_regex>> entries;
+		};
+
+		static inline cache& global_cache()
+		{
+			static cache instance;
+			return instance;
+		}
+	}
+
+	/*
+	* @returns the compiled form of 'pattern', every pattern is compiled only once per process
+	* @throws std::regex_error - if 'pattern' is not a valid ECMAScript regex
+	*/
+	static inline std::shared_ptr<const compiled_regex> cached_regex(const std::string& pattern)
+	{
+		_regex::cache& cache = _regex::global_cache();
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		std::unordered_map<std::string, std::shared_ptr<const compiled_regex>>::iterator iter = cache.entries.find(pattern);
+		if (iter == cache.entries.end())
+		{
+			iter = cache.entries.emplace(pattern, std::make_shared<const compiled_regex>(pattern)).first;
+		}
+		return iter->second;
+	}
+
+	/*
+	* drops every cached pattern, patterns still held elsewhere stay valid
+	*/
+	static inline void clear_regex_cache()
+	{
+		_regex::cache& cache = _regex::global_cache();
+		std::lock_guard<std::mutex> lock(cache.mutex);
+		cache.entries.clear();
+	}
+
 	struct regex_pattern
 	{
-		regex_pattern(const std::string& pattern) : pattern(pattern), regex(pattern) {}
+		regex_pattern(const std::string& pattern) : pattern(pattern), compiled(cached_regex(pattern)), regex(compiled->std_regex()) {}
 		std::string pattern;
+		std::shared_ptr<const compiled_regex> compiled;
 		std::regex  regex;
 	};
 
@@ -50,9 +873,20 @@ namespace util
 		return res;
 	}
 
-	static inline std::vector<std::string> split_string(const std::string& input, const util::regex_pattern& regex, bool no_empty_strings = true)
+	/*
+	* every match of 'regex' in 'input' as offsets and views into 'input', nothing is copied
+	*/
+	static inline std::vector<regex_match_view> find_matches(std::string_view input, const regex_pattern& regex)
 	{
-		std::vector<std::string> res;
+		return regex.compiled->find_all(input);
+	}
+
+	/*
+	* split_string() without copies, the pieces are views into 'input'
+	*/
+	static inline std::vector<std::string_view> split_string_view(std::string_view input, const util::regex_pattern& regex, bool no_empty_strings = true)
+	{
+		std::vector<std::string_view> res;
 
 		// if delimiter is "", input should be split at every index e.g. "input" would become { "i","n","p","u","t" }
 		if (!regex.pattern.length())
@@ -65,41 +899,42 @@ namespace util
 		}
 
 		// find possible split-spots
-		std::vector<regex_match> matches = get_matches(input, regex.regex);
+		std::vector<regex_match_view> matches = find_matches(input, regex);
 		if (matches.empty())
 		{
 			return res;
 		}
 
 		// get regions between split-spots
-		for (uint64_t i = 0; i < matches.size(); i++)
+		if (matches.front().index) // account for case that 'regex' is at the front
 		{
-			if (!i)
-			{
-				if (matches[i].index) // account for case that 'regex' is at the front
-				{
-					res.emplace_back(input.substr(0, matches[i].index));
-				}
-			}
-			else
-			{
-				res.emplace_back(input.substr(matches[i - 1].index + matches[i - 1].length, matches[i].index - (matches[i - 1].index + matches[i - 1].length)));
-			}
+			res.emplace_back(input.substr(0, matches.front().index));
+		}
+		for (size_t i = 1; i < matches.size(); i++)
+		{
+			size_t begin = matches[i - 1].index + matches[i - 1].length;
+			res.emplace_back(input.substr(begin, matches[i].index - begin));
 		}
 		if (matches.back().index + matches.back().length < input.length()) // account for case that 'regex' is at the end
 		{
-			res.emplace_back(input.substr(matches.back().index + matches.back().length, input.length() - matches.back().index));
+			res.emplace_back(input.substr(matches.back().index + matches.back().length));
 		}
 
 		// clear possible empty strings
 		if (no_empty_strings)
 		{
-			clear_empty_strings(res);
+			std::erase_if(res, [](std::string_view str) { return isempty(str); });
 		}
 
 		return res;
 	}
 
+	static inline std::vector<std::string> split_string(const std::string& input, const util::regex_pattern& regex, bool no_empty_strings = true)
+	{
+		std::vector<std::string_view> pieces = split_string_view(input, regex, no_empty_strings);
+		return std::vector<std::string>(pieces.begin(), pieces.end());
+	}
+
 }
 ////////////////////////////////////////
 #endif
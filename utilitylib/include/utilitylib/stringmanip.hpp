@@ -10,9 +10,22 @@
 ////////////////////////////////////////
 #include <vector>
 #include <string>
+#include <string_view>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <algorithm>
 #include <concepts>
 #include <iostream>
 ////////////////////////////////////////
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define UTILITYLIB_STRINGMANIP_SSE2
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define UTILITYLIB_STRINGMANIP_NEON
+#include <arm_neon.h>
+#endif
+////////////////////////////////////////
 /*
        ( (
         ) )
@@ -255,56 +268,285 @@ namespace util
 	}
 
 	/*
-	* considers a string empty if it does not contain any alphanumerical values or special characters
-	* (e.g. only whitespace or special ascii characters)
+	* ASCII kernels, 16 bytes at a time with SSE2 or NEON and scalar for the rest.
+	* a byte is in [first, first + count) if (byte - first) is below 'count' as unsigned value,
+	* SSE2 only compares signed so both sides are shifted by 0x80.
 	*/
-	static inline bool isempty(const std::string& str)
+	namespace _ascii
 	{
-		for (char c : str)
+		// @returns if any byte of [data, data + size) lies in [first, first + count)
+		static inline bool any_in_range(const char* data, size_t size, unsigned char first, unsigned char count)
 		{
-			if (c >= 33 && c <= 126)
+			size_t i = 0;
+#if defined(UTILITYLIB_STRINGMANIP_SSE2)
+			const __m128i offset = _mm_set1_epi8(static_cast<char>(first));
+			const __m128i bound = _mm_set1_epi8(static_cast<char>(count ^ 0x80));
+			const __m128i flip = _mm_set1_epi8(static_cast<char>(0x80));
+			for (; i + 16 <= size; i += 16)
+			{
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+				__m128i shifted = _mm_xor_si128(_mm_sub_epi8(bytes, offset), flip);
+				if (_mm_movemask_epi8(_mm_cmplt_epi8(shifted, bound)))
+				{
+					return true;
+				}
+			}
+#elif defined(UTILITYLIB_STRINGMANIP_NEON)
+			const uint8x16_t offset = vdupq_n_u8(first);
+			const uint8x16_t bound = vdupq_n_u8(count);
+			for (; i + 16 <= size; i += 16)
 			{
-				return false;
+				uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+				if (vmaxvq_u8(vcltq_u8(vsubq_u8(bytes, offset), bound)))
+				{
+					return true;
+				}
+			}
+#endif
+			for (; i < size; i++)
+			{
+				if (static_cast<unsigned char>(static_cast<unsigned char>(data[i]) - first) < count)
+				{
+					return true;
+				}
 			}
+			return false;
 		}
-		return true;
-	}
 
-	static inline void clear_empty_strings(std::vector<std::string>& vec)
-	{
-		for (std::vector<std::string>::iterator iter = vec.begin(); iter != vec.end();)
+		// flips the case bit (0x20) of every byte in [first, first + 26), 'src' and 'dst' may be the same
+		static inline void flip_case(const char* src, char* dst, size_t size, unsigned char first)
 		{
-			if (isempty(*iter))
+			size_t i = 0;
+#if defined(UTILITYLIB_STRINGMANIP_SSE2)
+			const __m128i offset = _mm_set1_epi8(static_cast<char>(first));
+			const __m128i bound = _mm_set1_epi8(static_cast<char>(26 ^ 0x80));
+			const __m128i flip = _mm_set1_epi8(static_cast<char>(0x80));
+			const __m128i case_bit = _mm_set1_epi8(0x20);
+			for (; i + 16 <= size; i += 16)
 			{
-				iter = vec.erase(iter);
+				__m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+				__m128i shifted = _mm_xor_si128(_mm_sub_epi8(bytes, offset), flip);
+				__m128i letters = _mm_cmplt_epi8(shifted, bound);
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_xor_si128(bytes, _mm_and_si128(letters, case_bit)));
 			}
-			else
+#elif defined(UTILITYLIB_STRINGMANIP_NEON)
+			const uint8x16_t offset = vdupq_n_u8(first);
+			const uint8x16_t bound = vdupq_n_u8(26);
+			const uint8x16_t case_bit = vdupq_n_u8(0x20);
+			for (; i + 16 <= size; i += 16)
+			{
+				uint8x16_t bytes = vld1q_u8(reinterpret_cast<const uint8_t*>(src + i));
+				uint8x16_t letters = vcltq_u8(vsubq_u8(bytes, offset), bound);
+				vst1q_u8(reinterpret_cast<uint8_t*>(dst + i), veorq_u8(bytes, vandq_u8(letters, case_bit)));
+			}
+#endif
+			for (; i < size; i++)
 			{
-				iter++;
+				unsigned char c = static_cast<unsigned char>(src[i]);
+				dst[i] = static_cast<char>(static_cast<unsigned char>(c - first) < 26 ? c ^ 0x20 : c);
 			}
 		}
 	}
 
-	static inline std::string tolowercase(const std::string& str)
+	/*
+	* considers a string empty if it does not contain any alphanumerical values or special characters
+	* (e.g. only whitespace or special ascii characters)
+	*/
+	static inline bool isempty(std::string_view str)
 	{
-		std::string res;
-		for (char c : str)
-		{
-			res.append(1, std::tolower(c));
-		}
+		return !_ascii::any_in_range(str.data(), str.size(), 33, 94); // 33 - 126
+	}
+
+	static inline void clear_empty_strings(std::vector<std::string>& vec)
+	{
+		// single compacting pass instead of erasing from the middle one by one
+		std::erase_if(vec, [](const std::string& str) { return isempty(str); });
+	}
+
+	/*
+	* converts ASCII letters in place, every other byte (including non-ASCII) is left as is
+	*/
+	static inline void tolowercase_inplace(char* data, size_t size)
+	{
+		_ascii::flip_case(data, data, size, 'A');
+	}
+
+	static inline void tolowercase_inplace(std::string& str)
+	{
+		tolowercase_inplace(str.data(), str.size());
+	}
+
+	static inline void touppercase_inplace(char* data, size_t size)
+	{
+		_ascii::flip_case(data, data, size, 'a');
+	}
+
+	static inline void touppercase_inplace(std::string& str)
+	{
+		touppercase_inplace(str.data(), str.size());
+	}
+
+	static inline std::string tolowercase(std::string_view str)
+	{
+		std::string res(str.size(), '\0');
+		_ascii::flip_case(str.data(), res.data(), str.size(), 'A');
 		return res;
 	}
 
-	static inline std::string touppercase(const std::string& str)
+	static inline std::string touppercase(std::string_view str)
 	{
-		std::string res;
-		for (char c : str)
+		std::string res(str.size(), '\0');
+		_ascii::flip_case(str.data(), res.data(), str.size(), 'a');
+		return res;
+	}
+
+	/*
+	* @returns offset of the first occurrence of 'delimiter' in 'str' or std::string_view::npos.
+	* memchr (vectorized by every common libc) finds candidates for the first character,
+	* single-character delimiters need nothing else.
+	*/
+	static inline size_t find_delimiter(std::string_view str, std::string_view delimiter)
+	{
+		if (delimiter.empty() || str.size() < delimiter.size())
 		{
-			res.append(1, std::toupper(c));
+			return delimiter.empty() ? 0 : std::string_view::npos;
 		}
-		return res;
+		const char* begin = str.data();
+		const char* last = begin + (str.size() - delimiter.size()); // last position a match can start at
+		for (const char* pos = begin; pos <= last; pos++)
+		{
+			pos = static_cast<const char*>(std::memchr(pos, delimiter.front(), static_cast<size_t>(last - pos) + 1));
+			if (!pos)
+			{
+				break;
+			}
+			if (delimiter.size() == 1 || !std::memcmp(pos + 1, delimiter.data() + 1, delimiter.size() - 1))
+			{
+				return static_cast<size_t>(pos - begin);
+			}
+		}
+		return std::string_view::npos;
 	}
 
+	/*
+	* lazy range over the pieces of a string between occurrences of a delimiter, e.g.
+	*   for (std::string_view field : util::split_view(line, ",")) { ... }
+	* the pieces are views into the input and nothing is allocated, so the input has to outlive the range.
+	* an empty delimiter yields every character on its own. with 'no_empty_strings' set, pieces for which
+	* isempty() holds are skipped while splitting.
+	*/
+	class split_view : public std::ranges::view_interface<split_view>
+	{
+	public:
+		class iterator
+		{
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type        = std::string_view;
+			using difference_type   = std::ptrdiff_t;
+			using pointer           = const std::string_view*;
+			using reference         = const std::string_view&;
+
+			iterator() = default;
+
+			reference operator*() const { return piece; }
+			pointer operator->() const { return &piece; }
+
+			iterator& operator++()
+			{
+				advance();
+				return *this;
+			}
+			iterator operator++(int)
+			{
+				iterator tmp = *this;
+				advance();
+				return tmp;
+			}
+
+			bool operator==(const iterator& other) const
+			{
+				if (done || other.done)
+				{
+					return done == other.done;
+				}
+				return piece.data() == other.piece.data() && rest.data() == other.rest.data();
+			}
+
+		private:
+			friend split_view;
+
+			iterator(const split_view* view) : view(view), rest(view->input), done(false)
+			{
+				advance();
+			}
+
+			void advance()
+			{
+				do
+				{
+					if (!next_piece())
+					{
+						done = true;
+						return;
+					}
+				} while (view->no_empty_strings && isempty(piece));
+			}
+
+			bool next_piece()
+			{
+				if (last_taken)
+				{
+					return false;
+				}
+				if (view->delimiter.empty())
+				{
+					if (rest.empty())
+					{
+						return false;
+					}
+					piece = rest.substr(0, 1);
+					rest.remove_prefix(1);
+					return true;
+				}
+				size_t pos = find_delimiter(rest, view->delimiter);
+				if (pos == std::string_view::npos)
+				{
+					piece = rest;
+					rest = rest.substr(rest.size());
+					last_taken = true;
+					return true;
+				}
+				piece = rest.substr(0, pos);
+				rest.remove_prefix(pos + view->delimiter.size());
+				return true;
+			}
+
+			const split_view* view = nullptr;
+			std::string_view piece;
+			std::string_view rest;        // input behind the current piece's delimiter
+			bool last_taken = false;      // piece behind the last delimiter was yielded
+			bool done = true;
+		};
+
+		split_view() = default;
+		split_view(std::string_view input, std::string_view delimiter, bool no_empty_strings = true)
+			: input(input), delimiter(delimiter), no_empty_strings(no_empty_strings) {}
+
+		iterator begin() const { return iterator(this); }
+		iterator end() const { return iterator(); }
+
+	private:
+		std::string_view input;
+		std::string_view delimiter;
+		bool no_empty_strings = true;
+	};
+
+	/*
+	* splits 'input' at every occurrence of 'delimiter' into copies of the pieces.
+	* pieces in front of the first and behind the last delimiter are dropped if they are empty,
+	* an input without the delimiter yields no pieces. see split_view for splitting without copies.
+	*/
 	static inline std::vector<std::string> split_string(const std::string& input, const std::string& delimiter, bool no_empty_strings = true)
 	{
 		std::vector<std::string> res;
@@ -312,50 +554,33 @@ namespace util
 		// if delimiter is "", input should be split at every index e.g. "input" would become { "i","n","p","u","t" }
 		if (!delimiter.length())
 		{
-			for (size_t i = 0; i < input.size(); i++)
+			for (std::string_view piece : split_view(input, delimiter, false))
 			{
-				res.emplace_back(input.substr(i,1));
+				res.emplace_back(piece);
 			}
 			return res;
 		}
-
-		// find possible split-spots
-		std::vector<size_t> indices;
-		size_t index = 0;
-		while ((index = input.find(delimiter, index)) != std::string::npos)
-		{
-			indices.emplace_back(index);
-			index += delimiter.length();
-		}
-		if (!indices.size())
+		if (find_delimiter(input, delimiter) == std::string::npos)
 		{
 			return res;
 		}
 
-		// get regions between split-spots
-		for (uint64_t i = 0; i < indices.size(); i++)
+		bool first = true;
+		std::string_view last_piece;
+		for (std::string_view piece : split_view(input, delimiter, no_empty_strings))
 		{
-			if (!i)
-			{
-				if (indices[i]) // account for case that 'split' is at the front
-				{
-					res.emplace_back(input.substr(0, indices[i]));
-				}
-			}
-			else
+			if (first && piece.empty() && piece.data() == input.data()) // account for case that 'split' is at the front
 			{
-				res.emplace_back(input.substr(indices[i - 1] + delimiter.length(), indices[i] - (indices[i - 1] + delimiter.length())));
+				first = false;
+				continue;
 			}
+			first = false;
+			res.emplace_back(piece);
+			last_piece = piece;
 		}
-		if (indices.back() + delimiter.length() < input.length()) // account for case that 'split' is at the end
-		{
-			res.emplace_back(input.substr(indices.back() + delimiter.length(), input.length() - indices.back()));
-		}
-
-		// clear possible empty strings
-		if (no_empty_strings)
+		if (!res.empty() && last_piece.empty() && last_piece.data() == input.data() + input.size()) // account for case that 'split' is at the end
 		{
-			clear_empty_strings(res);
+			res.pop_back();
 		}
 		return res;
 	}
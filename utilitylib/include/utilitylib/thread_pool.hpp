@@ -0,0 +1,251 @@
+////////////////////////////////////////
+/// general utility header-only-library
+/// for convenience methods/types in C++
+/// 2025 Julian Benzel
+////////////////////////////////////////
+/// work-stealing thread pool
+////////////////////////////////////////
+#ifndef UTILITYLIB_THREAD_POOL_HPP
+#define UTILITYLIB_THREAD_POOL_HPP
+////////////////////////////////////////
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+#include <functional>
+#include <type_traits>
+////////////////////////////////////////
+namespace util
+{
+	/*
+	* fixed-size pool of worker threads
+	*
+	* every worker owns a task queue. it takes new work from the back of its own queue
+	* and, once that is empty, steals from the front of the other workers' queues.
+	* tasks submitted from inside a worker go to that worker's queue, tasks from
+	* other threads are distributed round-robin.
+	*/
+	class thread_pool
+	{
+	public:
+		/*
+		* @param thread_count - number of worker threads, at least one
+		*/
+		explicit thread_pool(size_t thread_count = std::thread::hardware_concurrency())
+		{
+			if (!thread_count)
+			{
+				thread_count = 1;
+			}
+			for (size_t i = 0; i < thread_count; i++)
+			{
+				queues.emplace_back(std::make_unique<worker_queue>());
+			}
+			for (size_t i = 0; i < thread_count; i++)
+			{
+				workers.emplace_back([this, i]() { worker_loop(i); });
+			}
+		}
+
+		thread_pool(const thread_pool&) = delete;
+		thread_pool& operator=(const thread_pool&) = delete;
+
+		/*
+		* finishes all queued tasks, then joins the workers
+		*/
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(sleep_mutex);
+				stopping = true;
+			}
+			wakeup.notify_all();
+			for (std::thread& worker : workers)
+			{
+				worker.join();
+			}
+		}
+
+		/*
+		* @returns number of worker threads
+		*/
+		size_t size() const
+		{
+			return workers.size();
+		}
+
+		/*
+		* queues a task for execution
+		* @returns future for the result of 'func'
+		*/
+		template <typename Func>
+		std::future<std::invoke_result_t<Func>> submit(Func&& func)
+		{
+			using result_type = std::invoke_result_t<Func>;
+			std::shared_ptr<std::packaged_task<result_type()>> task =
+				std::make_shared<std::packaged_task<result_type()>>(std::forward<Func>(func));
+			std::future<result_type> res = task->get_future();
+			push([task]() { (*task)(); });
+			return res;
+		}
+
+		/*
+		* [blocking]
+		* calls 'func(i)' for every i in [0, count) on the pool. the calling thread takes part in the work,
+		* so this is safe to call from inside a task of the same pool.
+		*/
+		template <typename Func>
+		void parallel_for(size_t count, Func&& func)
+		{
+			if (!count)
+			{
+				return;
+			}
+			struct shared_state
+			{
+				std::atomic<size_t> next = 0;
+				std::atomic<size_t> done = 0;
+				std::mutex mutex;
+				std::condition_variable finished;
+				std::exception_ptr error;
+			};
+			std::shared_ptr<shared_state> state = std::make_shared<shared_state>();
+			std::function<void(size_t)> body = std::forward<Func>(func);
+			// helpers may start after all indices are taken, they then simply return.
+			// they only touch 'body' while holding an index, so it outlives every call.
+			auto run = [state, &body, count]()
+			{
+				size_t i;
+				while ((i = state->next.fetch_add(1)) < count)
+				{
+					try
+					{
+						body(i);
+					}
+					catch (...)
+					{
+						std::lock_guard<std::mutex> lock(state->mutex);
+						if (!state->error) { state->error = std::current_exception(); }
+					}
+					if (state->done.fetch_add(1) + 1 == count)
+					{
+						std::lock_guard<std::mutex> lock(state->mutex);
+						state->finished.notify_all();
+					}
+				}
+			};
+			size_t helpers = std::min(count - 1, size());
+			for (size_t i = 0; i < helpers; i++)
+			{
+				push(run);
+			}
+			run();
+			std::unique_lock<std::mutex> lock(state->mutex);
+			state->finished.wait(lock, [&]() { return state->done.load() == count; });
+			if (state->error)
+			{
+				std::rethrow_exception(state->error);
+			}
+		}
+
+		/*
+		* @returns process-wide pool with one worker per hardware thread
+		*/
+		static thread_pool& shared()
+		{
+			static thread_pool pool;
+			return pool;
+		}
+
+	private:
+
+		struct worker_queue
+		{
+			std::mutex mutex;
+			std::deque<std::function<void()>> tasks;
+		};
+
+		std::vector<std::unique_ptr<worker_queue>> queues;
+		std::vector<std::thread> workers;
+		std::atomic<size_t> next_queue = 0;
+		std::atomic<size_t> pending = 0;
+		std::mutex sleep_mutex;
+		std::condition_variable wakeup;
+		bool stopping = false;
+
+		static inline thread_local const thread_pool* current_pool = nullptr;
+		static inline thread_local size_t current_index = 0;
+
+		void push(std::function<void()> task)
+		{
+			size_t index = current_pool == this ? current_index : next_queue.fetch_add(1) % queues.size();
+			{
+				// counted before it is queued, so 'pending' never drops below the number of queued tasks
+				std::lock_guard<std::mutex> lock(sleep_mutex);
+				pending.fetch_add(1);
+			}
+			{
+				std::lock_guard<std::mutex> lock(queues[index]->mutex);
+				queues[index]->tasks.emplace_back(std::move(task));
+			}
+			wakeup.notify_one();
+		}
+
+		bool try_pop(size_t self, std::function<void()>& task)
+		{
+			for (size_t offset = 0; offset < queues.size(); offset++)
+			{
+				worker_queue& queue = *queues[(self + offset) % queues.size()];
+				std::lock_guard<std::mutex> lock(queue.mutex);
+				if (queue.tasks.empty())
+				{
+					continue;
+				}
+				if (!offset) // own queue: newest first
+				{
+					task = std::move(queue.tasks.back());
+					queue.tasks.pop_back();
+				}
+				else // steal the oldest task of another worker
+				{
+					task = std::move(queue.tasks.front());
+					queue.tasks.pop_front();
+				}
+				pending.fetch_sub(1);
+				return true;
+			}
+			return false;
+		}
+
+		void worker_loop(size_t index)
+		{
+			current_pool = this;
+			current_index = index;
+			std::function<void()> task;
+			while (true)
+			{
+				if (try_pop(index, task))
+				{
+					task();
+					task = nullptr;
+					continue;
+				}
+				std::unique_lock<std::mutex> lock(sleep_mutex);
+				wakeup.wait(lock, [this]() { return stopping || pending.load() > 0; });
+				if (stopping && !pending.load())
+				{
+					return;
+				}
+			}
+		}
+	};
+}
+////////////////////////////////////////
+#endif
+////////////////////////////////////////
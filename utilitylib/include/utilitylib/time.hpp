@@ -8,15 +8,172 @@
 #ifndef UTILITYLIB_TIME_HPP
 #define UTILITYLIB_TIME_HPP
 ////////////////////////////////////////
-#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
 #include <string>
+#include <string_view>
+#include <span>
 #include <chrono>
 #include <ctime>
-#include <iomanip>
+#include <ostream>
 #include <functional>
+#include <memory>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <unordered_map>
 ////////////////////////////////////////
 namespace util
 {
+	namespace _time
+	{
+		static inline std::tm utc(std::time_t time)
+		{
+			std::tm res = std::tm();
+#if defined(_WIN32)
+			gmtime_s(&res, &time);
+#else
+			gmtime_r(&time, &res);
+#endif
+			return res;
+		}
+
+		// strftime into 'out', growing it until the result fits
+		static inline void render(const std::string& format, int64_t second, std::string& out)
+		{
+			const std::tm time = utc(static_cast<std::time_t>(second));
+			out.resize(std::max<size_t>(out.capacity(), format.size() * 4 + 32));
+			while (true)
+			{
+				size_t length = std::strftime(out.data(), out.size(), format.c_str(), &time);
+				// 0 is also the correct length of an empty result, which cannot need more than a few bytes
+				if (length || out.size() > format.size() * 64 + 256)
+				{
+					out.resize(length);
+					return;
+				}
+				out.resize(out.size() * 2);
+			}
+		}
+	}
+
+	/*
+	* renders timestamps with a strftime format, for callers that format many of them (log lines)
+	*
+	* the text of the last second is cached. within the same minute only the two seconds digits
+	* are rewritten, and strftime only runs once a minute. this needs the format to show the seconds
+	* exactly once as two digits (%S, %T), other formats are rendered once per second.
+	* not thread-safe, every thread should use its own formatter.
+	*/
+	class timestamp_formatter
+	{
+	public:
+		explicit timestamp_formatter(std::string format)
+			: format_str(std::move(format))
+		{
+		}
+
+		const std::string& format_string() const
+		{
+			return format_str;
+		}
+
+		/*
+		* @returns text for 'time_point', valid until the next call on this formatter
+		*/
+		std::string_view format(std::chrono::system_clock::time_point time_point)
+		{
+			update(std::chrono::floor<std::chrono::seconds>(time_point).time_since_epoch().count());
+			return rendered;
+		}
+
+		/*
+		* writes the text for 'time_point' into 'out', without allocating
+		* @returns number of characters written, 0 if 'out' is too small
+		*/
+		size_t format(std::chrono::system_clock::time_point time_point, std::span<char> out)
+		{
+			std::string_view text = format(time_point);
+			if (text.size() > out.size())
+			{
+				return 0;
+			}
+			std::memcpy(out.data(), text.data(), text.size());
+			return text.size();
+		}
+
+		size_t format_now(std::span<char> out)
+		{
+			return format(std::chrono::system_clock::now(), out);
+		}
+
+	private:
+		static constexpr size_t no_offset = static_cast<size_t>(-1);
+
+		std::string format_str;
+		std::string rendered;
+		std::string probe;
+		int64_t rendered_second = INT64_MIN;
+		int64_t rendered_minute = INT64_MIN;
+		size_t seconds_offset = no_offset; // position of the seconds digits in 'rendered'
+
+		void update(int64_t second)
+		{
+			if (second == rendered_second)
+			{
+				return;
+			}
+			const int64_t minute = second / 60 * 60 - (second % 60 < 0 ? 60 : 0);
+			const int64_t second_of_minute = second - minute;
+			if (minute == rendered_minute && seconds_offset != no_offset)
+			{
+				rendered[seconds_offset] = static_cast<char>('0' + second_of_minute / 10);
+				rendered[seconds_offset + 1] = static_cast<char>('0' + second_of_minute % 10);
+				rendered_second = second;
+				return;
+			}
+			// find the seconds digits by rendering :00 and :11 of this minute, they have to differ in exactly two adjacent places
+			_time::render(format_str, minute, rendered);
+			_time::render(format_str, minute + 11, probe);
+			seconds_offset = no_offset;
+			if (rendered.size() == probe.size())
+			{
+				size_t first = rendered.size();
+				size_t differences = 0;
+				for (size_t i = 0; i < rendered.size(); i++)
+				{
+					if (rendered[i] != probe[i])
+					{
+						first = std::min(first, i);
+						differences++;
+					}
+				}
+				if (differences == 2 && rendered.compare(first, 2, "00") == 0 && probe.compare(first, 2, "11") == 0)
+				{
+					seconds_offset = first;
+				}
+			}
+			rendered_minute = minute;
+			if (seconds_offset != no_offset)
+			{
+				rendered[seconds_offset] = static_cast<char>('0' + second_of_minute / 10);
+				rendered[seconds_offset + 1] = static_cast<char>('0' + second_of_minute % 10);
+			}
+			else
+			{
+				_time::render(format_str, second, rendered);
+			}
+			rendered_second = second;
+		}
+	};
+
+	/*
+	* point in time with a strftime format, rendered in utc. the text is only rendered when it is asked for.
+	*/
 	class timestamp
 	{
 	public:
@@ -38,7 +195,6 @@ namespace util
 		void setformat(const std::string& format)
 		{
 			this->format = format;
-			update_timestamp_str();
 		}
 
 		inline std::chrono::milliseconds milliseconds_since_epoch() const
@@ -48,17 +204,35 @@ namespace util
 
 		inline std::string to_string() const
 		{
-			return this->timestamp_str;
+			return std::string(thread_formatter(format).format(time_point));
+		}
+
+		/*
+		* writes the text into 'out' without allocating
+		* @returns number of characters written, 0 if 'out' is too small
+		*/
+		inline size_t to_chars(std::span<char> out) const
+		{
+			return thread_formatter(format).format(time_point, out);
 		}
 
 		inline operator std::string()
 		{
-			return this->timestamp_str;
+			return to_string();
 		}
 
 		static inline std::string get()
 		{
-			return timestamp().timestamp_str;
+			return std::string(thread_formatter(default_format).format(std::chrono::system_clock::now()));
+		}
+
+		/*
+		* writes the current time in 'default_format' into 'out' without allocating
+		* @returns number of characters written, 0 if 'out' is too small
+		*/
+		static inline size_t get(std::span<char> out)
+		{
+			return thread_formatter(default_format).format_now(out);
 		}
 
 		template <typename Rep, typename Period>
@@ -66,7 +240,6 @@ namespace util
 		{
 			timestamp res(*this);
 			res.time_point += p;
-			res.update_timestamp_str();
 			return res;
 		}
 
@@ -75,7 +248,6 @@ namespace util
 		{
 			timestamp res(*this);
 			res.time_point -= p;
-			res.update_timestamp_str();
 			return res;
 		}
 
@@ -83,7 +255,6 @@ namespace util
 		timestamp& operator+=(std::chrono::duration<Rep, Period> p)
 		{
 			this->time_point += p;
-			update_timestamp_str();
 			return *this;
 		}
 
@@ -91,7 +262,6 @@ namespace util
 		timestamp& operator-=(std::chrono::duration<Rep, Period> p)
 		{
 			this->time_point -= p;
-			update_timestamp_str();
 			return *this;
 		}
 
@@ -99,7 +269,6 @@ namespace util
 		{
 			timestamp res(*this);
 			res.time_point += t.time_point.time_since_epoch();
-			res.update_timestamp_str();
 			return res;
 		}
 
@@ -107,7 +276,6 @@ namespace util
 		{
 			timestamp res(*this);
 			res.time_point -= t.time_point.time_since_epoch();
-			res.update_timestamp_str();
 			return res;
 		}
 
@@ -115,44 +283,373 @@ namespace util
 
 		std::chrono::time_point<std::chrono::system_clock, std::chrono::milliseconds> time_point;
 		std::string format;
-		std::string timestamp_str;
 
-		void update_timestamp_str()
+		// one cached formatter per thread, rebuilt when a different format comes along
+		static timestamp_formatter& thread_formatter(const std::string& format)
 		{
-			std::time_t _time_t = std::chrono::system_clock::to_time_t(time_point);
-			std::tm _tm = std::tm();
-			gmtime_s(&_tm, &_time_t);
-			
-			std::stringstream sstream;
-			sstream << std::put_time(&_tm, format.c_str());
-			timestamp_str = sstream.str();
+			thread_local timestamp_formatter formatter(default_format);
+			if (formatter.format_string() != format)
+			{
+				formatter = timestamp_formatter(format);
+			}
+			return formatter;
 		}
 	};
 
 	static inline std::ostream& operator<<(std::ostream& os, const timestamp& ts)
 	{
-		os << ts.to_string();
+		// written as characters, stringmanip's operator<< for containers would match std::string as well
+		const std::string text = ts.to_string();
+		os.write(text.data(), static_cast<std::streamsize>(text.size()));
 		return os;
 	}
 
+	class timer_scheduler;
+
+	/*
+	* cooperative cancellation shared between a task and everyone who may stop it. a token can carry a deadline:
+	* tokens from a timer_scheduler are cancelled by its thread when the deadline passes, so checking them is
+	* a single atomic load. tokens constructed with a deadline compare it against steady_clock themselves.
+	*/
+	class cancellation_token
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+
+		cancellation_token()
+			: shared(std::make_shared<state>())
+		{
+		}
+
+		explicit cancellation_token(clock::time_point deadline)
+			: shared(std::make_shared<state>())
+		{
+			shared->deadline = deadline;
+		}
+
+		/*
+		* also releases the deadline timer of tokens from a timer_scheduler
+		*/
+		void cancel();
+
+		bool cancelled() const
+		{
+			if (shared->cancelled.load(std::memory_order_acquire))
+			{
+				return true;
+			}
+			return !shared->watched && shared->deadline != clock::time_point::max() && clock::now() >= shared->deadline;
+		}
+
+		clock::time_point deadline() const
+		{
+			return shared->deadline;
+		}
+
+	private:
+		friend class timer_scheduler;
+
+		struct state
+		{
+			std::atomic<bool> cancelled = false;
+			clock::time_point deadline = clock::time_point::max();
+			bool watched = false; // a timer_scheduler cancels it at the deadline
+			std::atomic<timer_scheduler*> scheduler = nullptr; // scheduler whose task 'timer' is still pending
+			uint64_t timer = 0;
+
+			// the last token going away cancels the pending deadline task
+			~state();
+
+			void release_timer();
+		};
+
+		std::shared_ptr<state> shared;
+	};
+
+	/*
+	* one background thread that runs one-shot and periodic tasks at steady_clock time points
+	*
+	* pending tasks sit in a binary min-heap on their due time, scheduling and cancelling are O(log n).
+	* cancelled tasks are dropped when they come due, or earlier when they make up most of the heap.
+	* tasks run on the timer thread one after another, so they should be short and hand longer work
+	* to a thread_pool. they may schedule and cancel other tasks. exceptions thrown by tasks are dropped.
+	*/
+	class timer_scheduler
+	{
+	public:
+		using clock = std::chrono::steady_clock;
+		using task_id = uint64_t;
+
+		timer_scheduler()
+		{
+			worker = std::thread([this]() { run(); });
+		}
+
+		timer_scheduler(const timer_scheduler&) = delete;
+		timer_scheduler& operator=(const timer_scheduler&) = delete;
+
+		/*
+		* stops the timer thread, pending tasks do not run anymore
+		*/
+		~timer_scheduler()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			wakeup.notify_all();
+			worker.join();
+		}
+
+		/*
+		* @returns id for cancel()
+		*/
+		task_id schedule_at(clock::time_point due, std::function<void()> task)
+		{
+			return add(due, clock::duration::zero(), std::move(task));
+		}
+
+		template <typename Rep, typename Period>
+		task_id schedule_after(std::chrono::duration<Rep, Period> delay, std::function<void()> task)
+		{
+			return add(clock::now() + std::chrono::duration_cast<clock::duration>(delay), clock::duration::zero(), std::move(task));
+		}
+
+		/*
+		* runs 'task' every 'period', the first time after one period. runs that were missed because the
+		* timer thread was busy are skipped instead of being caught up in a burst.
+		*/
+		template <typename Rep, typename Period>
+		task_id schedule_every(std::chrono::duration<Rep, Period> period, std::function<void()> task)
+		{
+			const clock::duration interval = std::max<clock::duration>(std::chrono::duration_cast<clock::duration>(period), clock::duration(1));
+			return add(clock::now() + interval, interval, std::move(task));
+		}
+
+		/*
+		* @returns false if the task already ran (one-shot) or was cancelled before.
+		* a periodic task that is running right now finishes that run.
+		*/
+		bool cancel(task_id id)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (!tasks.erase(id))
+			{
+				return false;
+			}
+			if (heap.size() > 2 * tasks.size() + 1024)
+			{
+				compact();
+			}
+			return true;
+		}
+
+		/*
+		* @returns token that is cancelled when 'deadline' passes (or when it is cancelled by hand).
+		* the deadline task is cancelled once the token is cancelled by hand or its last copy is gone, so dropped
+		* tokens do not pile up in the heap. until its deadline has passed a token must not outlive the scheduler.
+		*/
+		cancellation_token token_at(clock::time_point deadline)
+		{
+			cancellation_token token(deadline);
+			token.shared->watched = true;
+			token.shared->scheduler = this; // set before the task exists, it may already be due
+			std::weak_ptr<cancellation_token::state> watched = token.shared;
+			token.shared->timer = schedule_at(deadline, [watched]()
+			{
+				if (std::shared_ptr<cancellation_token::state> expired = watched.lock())
+				{
+					expired->scheduler = nullptr; // the task is done, nothing left to cancel
+					expired->cancelled.store(true, std::memory_order_release);
+				}
+			});
+			return token;
+		}
+
+		template <typename Rep, typename Period>
+		cancellation_token token_after(std::chrono::duration<Rep, Period> timeout)
+		{
+			return token_at(clock::now() + std::chrono::duration_cast<clock::duration>(timeout));
+		}
+
+		/*
+		* @returns number of tasks that are scheduled and not cancelled
+		*/
+		size_t pending()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return tasks.size();
+		}
+
+		/*
+		* @returns process-wide scheduler
+		*/
+		static timer_scheduler& shared()
+		{
+			static timer_scheduler scheduler;
+			return scheduler;
+		}
+
+	private:
+
+		struct task_state
+		{
+			std::function<void()> func;
+			clock::duration period; // zero for one-shot tasks
+			clock::time_point due;
+		};
+
+		struct heap_entry
+		{
+			clock::time_point due;
+			task_id id;
+
+			bool operator>(const heap_entry& other) const
+			{
+				return due > other.due;
+			}
+		};
+
+		std::mutex mutex;
+		std::condition_variable wakeup;
+		std::vector<heap_entry> heap; // min-heap through std::greater
+		std::unordered_map<task_id, std::shared_ptr<task_state>> tasks;
+		task_id next_id = 1;
+		bool stopping = false;
+		std::thread worker;
+
+		task_id add(clock::time_point due, clock::duration period, std::function<void()> task)
+		{
+			task_id id;
+			bool earliest;
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				id = next_id++;
+				tasks.emplace(id, std::make_shared<task_state>(task_state{ std::move(task), period, due }));
+				earliest = heap.empty() || due < heap.front().due;
+				heap.push_back(heap_entry{ due, id });
+				std::push_heap(heap.begin(), heap.end(), std::greater<heap_entry>());
+			}
+			if (earliest)
+			{
+				wakeup.notify_one();
+			}
+			return id;
+		}
+
+		// drops the heap entries of cancelled tasks, the mutex has to be held
+		void compact()
+		{
+			std::erase_if(heap, [this](const heap_entry& entry) { return !tasks.contains(entry.id); });
+			std::make_heap(heap.begin(), heap.end(), std::greater<heap_entry>());
+		}
+
+		void run()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (!stopping)
+			{
+				if (heap.empty())
+				{
+					wakeup.wait(lock);
+					continue;
+				}
+				const clock::time_point due = heap.front().due;
+				if (clock::now() < due)
+				{
+					wakeup.wait_until(lock, due);
+					continue;
+				}
+				const task_id id = heap.front().id;
+				std::pop_heap(heap.begin(), heap.end(), std::greater<heap_entry>());
+				heap.pop_back();
+				std::unordered_map<task_id, std::shared_ptr<task_state>>::iterator found = tasks.find(id);
+				if (found == tasks.end() || found->second->due != due)
+				{
+					continue; // cancelled
+				}
+				std::shared_ptr<task_state> task = found->second;
+				if (task->period == clock::duration::zero())
+				{
+					tasks.erase(found);
+				}
+				lock.unlock();
+				try
+				{
+					task->func();
+				}
+				catch (...)
+				{
+					// nobody to report it to, the timer thread has to keep going
+				}
+				lock.lock();
+				if (task->period != clock::duration::zero())
+				{
+					found = tasks.find(id);
+					if (found != tasks.end() && found->second == task)
+					{
+						const clock::time_point now = clock::now();
+						task->due += task->period;
+						if (task->due <= now)
+						{
+							task->due = now + task->period;
+						}
+						heap.push_back(heap_entry{ task->due, id });
+						std::push_heap(heap.begin(), heap.end(), std::greater<heap_entry>());
+					}
+				}
+			}
+		}
+	};
+
+	inline void cancellation_token::cancel()
+	{
+		shared->cancelled.store(true, std::memory_order_release);
+		shared->release_timer();
+	}
+
+	inline cancellation_token::state::~state()
+	{
+		release_timer();
+	}
+
+	inline void cancellation_token::state::release_timer()
+	{
+		if (timer_scheduler* owner = scheduler.exchange(nullptr))
+		{
+			owner->cancel(timer);
+		}
+	}
+
 	/*
 	* [blocking]
-	* executes the passed function as often as it can for the specified time frame.
+	* executes the passed function as often as it can for the specified time frame, or until it sets 'quit'.
+	* the time frame is watched by timer_scheduler::shared(), so every iteration only checks a flag.
 	* amount of times the function gets executed may vary and strongly depend on resource allocation
-	* 
-	* to do: should count time in another thread and cancel if timeout is reached or sth
-	* somehow blocking functions need to be canceled after timeout
 	*/
 	template <typename Rep, typename Period>
 	static inline void execute_for_time(std::function<void(bool& quit)> func, std::chrono::duration<Rep, Period> time_frame)
 	{
-		timestamp current_time;
-		timestamp end_time = current_time.milliseconds_since_epoch() + std::chrono::duration_cast<std::chrono::milliseconds>(time_frame);
+		cancellation_token token = timer_scheduler::shared().token_after(time_frame);
 		bool quit = false;
-		while (current_time.milliseconds_since_epoch() < end_time.milliseconds_since_epoch() && !quit)
+		while (!quit && !token.cancelled())
 		{
 			func(quit);
-			current_time = timestamp();
+		}
+	}
+
+	/*
+	* [blocking]
+	* like above, but 'func' receives the token, so that long or blocking calls inside it can stop
+	* as soon as the time frame is over instead of only between iterations
+	*/
+	template <typename Rep, typename Period>
+	static inline void execute_for_time(std::function<void(const cancellation_token& token)> func, std::chrono::duration<Rep, Period> time_frame)
+	{
+		cancellation_token token = timer_scheduler::shared().token_after(time_frame);
+		while (!token.cancelled())
+		{
+			func(token);
 		}
 	}
 }
@@ -9,11 +9,22 @@
 #define UTIL_TREE_HPP
 ////////////////////////////////////////
 #include <memory>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
 #include <iterator>
 #include <list>
+#include <unordered_map>
+#include <unordered_set>
+#include <string_view>
+#include <concepts>
 #include <algorithm>
 #include <functional>
+#include <vector>
+#include <deque>
+#include <utility>
+#include "thread_pool.hpp"
+#include "macros.hpp"
 ////////////////////////////////////////
 namespace util
 {
@@ -27,6 +38,67 @@ namespace util
 		}
 	};
 
+	/*
+	 * bump allocator for bulk node allocation: hands out memory from large blocks
+	 * and frees nothing before the arena itself is destroyed.
+	 * it only backs one deep copy, so the memory it holds is bounded by the node count of that copy
+	 */
+	class node_arena {
+	public:
+		/*
+		 * @param _expected - number of allocations the first block is sized for
+		 */
+		explicit node_arena(std::size_t _expected) : m_expected(std::max<std::size_t>(_expected, 1ULL)) {}
+
+		void* allocate(std::size_t _bytes, std::size_t _align) {
+			std::size_t _pad = _padding(_align);
+			if (!m_cur || _pad + _bytes > m_left) {
+				std::size_t _slot = (_bytes + _align - 1ULL) / _align * _align;
+				std::size_t _block = _slot * m_expected + _align;
+				m_blocks.emplace_back(new std::byte[_block]);
+				m_cur = m_blocks.back().get();
+				m_left = _block;
+				m_expected = std::max<std::size_t>(m_expected / 4ULL, 64ULL); // only hit when the estimate was too small
+				_pad = _padding(_align);
+			}
+			std::byte* _res = m_cur + _pad;
+			m_cur = _res + _bytes;
+			m_left -= _pad + _bytes;
+			return _res;
+		}
+
+	private:
+		std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+		std::byte* m_cur = nullptr;
+		std::size_t m_left = 0ULL;
+		std::size_t m_expected;
+
+		std::size_t _padding(std::size_t _align) const {
+			return m_cur ? (_align - reinterpret_cast<std::uintptr_t>(m_cur) % _align) % _align : 0ULL;
+		}
+	};
+
+	/*
+	 * allocator for std::allocate_shared on top of a shared node_arena.
+	 * every control block keeps a copy, so the arena lives until the last node allocated from it is gone
+	 */
+	template <typename _Ty>
+	struct node_arena_allocator {
+		using value_type = _Ty;
+
+		std::shared_ptr<node_arena> m_arena;
+
+		explicit node_arena_allocator(std::shared_ptr<node_arena> _arena) : m_arena(std::move(_arena)) {}
+		template <typename _Other>
+		node_arena_allocator(const node_arena_allocator<_Other>& _other) : m_arena(_other.m_arena) {}
+
+		_Ty* allocate(std::size_t _n) { return static_cast<_Ty*>(m_arena->allocate(_n * sizeof(_Ty), alignof(_Ty))); }
+		void deallocate(_Ty*, std::size_t) noexcept {} // no-op, the blocks are released with the arena, see node_arena
+
+		template <typename _Other>
+		bool operator==(const node_arena_allocator<_Other>& _other) const { return m_arena == _other.m_arena; }
+	};
+
 	////////////////////////////////////////
 	/*
 	 * C++ implementation of an iterable tree-data-structure
@@ -38,21 +110,31 @@ namespace util
   	 * actually i already have a more performant approach. instead of leaving ownership with the nodes, you store every node in a std::unordered_map
          * and each node stores keys to adjacent nodes (parent, children, siblings)
 	 * after some testing i found that this is way faster than this pointer-based approach
+	 * (an index-based variant of that idea is available as util::pool_tree in pool_tree.hpp)
 	 * 
 	 * features:
 	 * - tree-concatenation: trees can be merged. you can put nodes of one tree on a node of another
-	 * - filter: you can search for nodes whose value satisfies a certain condition
-	 * - iterable: with an iterator you can get from one node to the next/previous node (using a depth-first-search algorithm)
+	 * - filter: you can search for nodes whose value satisfies a certain condition, serially or split into subtree-tasks on a util::thread_pool
+	 * - iterable: with an iterator you can get from one node to the next/previous node (using a depth-first-search algorithm).
+	 *   const- and reverse-iterators walk the same order, post-order-, breadth-first- and level-iterators are available as well.
+	 *   none of them recurse, they follow the node links or an explicit queue and prefetch the nodes they visit next
+	 * - bookkeeping: the root keeps the node count of the tree, so size() is O(1). every node caches the size and height of its subtree,
+	 *   modifications only mark the path to the root (until an already marked node), the next subtree_size() or height() recomputes the
+	 *   marked nodes, so inserting is O(1) amortized even in chains
+	 * - huge trees: destruction and deep copies use explicit stacks instead of recursion, copies allocate their nodes from one bulk arena
+	 * - index: opt-in hash index from values to nodes plus path access like at_path("config/network/port"), see enable_index()
+	 * - snapshots: write_snapshot() stores a flat pre-order file that util::tree_view maps without parsing (tree_snapshot.hpp)
 	 * 
 	 * to-do:
-	 * - reverse iterator
-	 * - const iterator
 	 * - unit testing
 	 * 
 	 * possible issues:
-	 * - tree structure is recursive, a parent-node has ownership and cleanup-responsibility for its children. therefore large trees may lead to stack-overflow.
-	 * - for deletion/iteration it is important to know in which container a node resides. for that, a node asks it's parent for an iterator to itself.
-	 *   this may be suboptimal as you could maybe store that iterator when using std::list.
+	 * - tree structure is recursive, a parent-node has ownership and cleanup-responsibility for its children. a node therefore takes its
+	 *   descendants apart iteratively when it is destroyed, otherwise large trees may lead to stack-overflow.
+	 * - memory of nodes that were created by a deep copy is returned once every node of that copy is gone. erasing parts of a copy does
+	 *   not shrink it, a copy holds at most the memory of the nodes it was created with (copying it again compacts it).
+	 * - for deletion/iteration it is important to know in which container a node resides. every node stores the std::list iterator
+	 *   to itself in its parent's child-list (std::list iterators stay valid), so sibling-navigation, erasing and iterating are O(1) per step.
 	 * - when using smart-pointers there are a lot of promotions from weak_ptr to shared_ptr as well as dereferences to traverse the tree. 
 	 *   this may cause performance overhead.
 	 */
@@ -66,6 +148,10 @@ namespace util
 		////////////////////////////////////////
 		class node;
 		class iterator;
+		class const_iterator;
+		class reverse_iterator;
+		class post_order_iterator;
+		class breadth_first_iterator;
 
 		friend node;
 		friend iterator;
@@ -79,6 +165,61 @@ namespace util
 		using node_wptr = std::weak_ptr<node>;
 		using node_ptr_list = std::list<node_ptr>;
 
+		/*
+		 * values can be indexed (enable_index()) if they are hashable and comparable
+		 */
+		static constexpr bool indexable = requires(const value_type& _val) {
+			{ std::hash<value_type>{}(_val) } -> std::convertible_to<std::size_t>;
+			{ _val == _val } -> std::convertible_to<bool>;
+		};
+
+	private:
+
+		////////////////////////////////////////
+		/// opt-in index
+		////////////////////////////////////////
+
+		/*
+		 * @brief lookup structures of an indexed tree, every node of the tree points to it
+		 */
+		struct _value_index {
+			std::unordered_map<value_type, std::unordered_set<node*>> m_nodes; // value -> every node holding it
+			std::unordered_map<const node*, std::unordered_multimap<value_type, node*>> m_children; // child hashes of high fan-out nodes
+			std::size_t m_child_threshold = 16ULL;
+
+			void _add(node* _ptr) {
+				m_nodes[_ptr->value()].insert(_ptr);
+			}
+			void _remove(node* _ptr) {
+				typename std::unordered_map<value_type, std::unordered_set<node*>>::iterator _iter = m_nodes.find(_ptr->value());
+				if (_iter == m_nodes.end()) { return; }
+				_iter->second.erase(_ptr);
+				if (_iter->second.empty()) { m_nodes.erase(_iter); }
+			}
+			void _build_children(const node* _parent) {
+				std::unordered_multimap<value_type, node*>& _map = m_children[_parent];
+				_map.clear();
+				_map.reserve(_parent->m_children.size());
+				for (const node_ptr& _child : _parent->m_children) { _map.emplace(_child->value(), _child.get()); }
+			}
+			// the child hash is created once the parent reaches the threshold, afterwards it is kept up to date
+			void _add_child(const node* _parent, node* _child) {
+				typename std::unordered_map<const node*, std::unordered_multimap<value_type, node*>>::iterator _iter = m_children.find(_parent);
+				if (_iter != m_children.end()) { _iter->second.emplace(_child->value(), _child); }
+				else if (_parent->m_children.size() >= m_child_threshold) { _build_children(_parent); }
+			}
+			void _remove_child(const node* _parent, node* _child) {
+				typename std::unordered_map<const node*, std::unordered_multimap<value_type, node*>>::iterator _iter = m_children.find(_parent);
+				if (_iter == m_children.end()) { return; }
+				std::pair<typename std::unordered_multimap<value_type, node*>::iterator, typename std::unordered_multimap<value_type, node*>::iterator> _range = _iter->second.equal_range(_child->value());
+				for (; _range.first != _range.second; ++_range.first) {
+					if (_range.first->second == _child) { _iter->second.erase(_range.first); break; }
+				}
+			}
+		};
+		struct _no_index {};
+		using _index_type = std::conditional_t<indexable, _value_index, _no_index>;
+
 	public:
 
 		////////////////////////////////////////
@@ -89,16 +230,80 @@ namespace util
 		{
 			friend tree;
 			friend iterator;
+			friend post_order_iterator;
+			friend breadth_first_iterator;
 		
 			unique_val m_val = nullptr;
 			node_wptr m_parent;
 			node_ptr_list m_children;
 			std::size_t m_depth = NULL;
+			typename node_ptr_list::iterator m_self; // position of this node in the parent's m_children
+			node* m_parent_ptr = nullptr; // raw copy of m_parent for the bookkeeping walks to the root
+			node* m_top = this; // root node of the tree
+			mutable std::size_t m_subtree_size = 1ULL; // this node and all of its descendants, only valid if !m_stats_dirty (always valid in the root)
+			mutable std::size_t m_height = 0ULL; // longest distance to a descendant leaf, only valid if !m_stats_dirty
+			mutable bool m_stats_dirty = false; // if set, all ancestors are dirty as well
+			_index_type* m_index = nullptr; // index of the tree, nullptr if it is not indexed
 
-			void _set_val(const value_type& _val) { if (!m_val) { m_val = std::make_unique<value_type>(_val); } else { *m_val = _val; } }
-			void _set_parent(node_ptr _ptr) { if (!_ptr) { throw std::runtime_error("parent node was nullptr"); }  m_parent = _ptr; }
+			void _set_val(const value_type& _val) {
+				if constexpr (indexable) {
+					if (m_index && m_val) { m_index->_remove(this); m_index->_remove_child(_parent_raw(), this); }
+				}
+				if (!m_val) { m_val = std::make_unique<value_type>(_val); } else { *m_val = _val; }
+				if constexpr (indexable) {
+					if (m_index) { m_index->_add(this); m_index->_add_child(_parent_raw(), this); }
+				}
+			}
+			/*
+			 * @brief registers this (already linked) node in '_index' and its parent's child hash, nullptr for unindexed trees
+			 */
+			void _index_attach(_index_type* _index) {
+				if constexpr (indexable) {
+					m_index = _index;
+					if (m_index) { m_index->_add(this); m_index->_add_child(_parent_raw(), this); }
+				}
+			}
+			void _set_parent(node_ptr _ptr) { if (!_ptr) { throw std::runtime_error("parent node was nullptr"); }  m_parent = _ptr; m_parent_ptr = _ptr.get(); }
 			void _set_depth(std::size_t _d) { m_depth = _d; }
 			node_ptr _parent() { return node_ptr(m_parent); }
+			node* _parent_raw() const { return m_parent_ptr; } // parent owns this node, so it is alive as long as this node is
+
+			void _release_inner_children(std::vector<node_ptr>& _stack) {
+				for (node_ptr& _child : m_children) {
+					if (_child && _child.use_count() == 1 && !_child->m_children.empty()) { _stack.emplace_back(std::move(_child)); }
+				}
+			}
+			/*
+			 * @brief bookkeeping after '_delta' nodes were linked below (or unlinked from) this node, O(1) amortized.
+			 * adds '_delta' to the node count in the root and marks this node and its ancestors up to the first one that is marked already
+			 */
+			void _on_children_changed(std::ptrdiff_t _delta) {
+				m_top->m_subtree_size = static_cast<std::size_t>(static_cast<std::ptrdiff_t>(m_top->m_subtree_size) + _delta);
+				for (const node* _p = this; _p && !_p->m_stats_dirty; _p = _p->_parent_raw()) { _p->m_stats_dirty = true; }
+			}
+			/*
+			 * @brief recomputes size and height of the dirty nodes in this subtree with an explicit stack, clean subtrees answer in O(1)
+			 */
+			void _refresh() const {
+				if (!m_stats_dirty) { return; }
+				std::vector<const node*> _stack{ this };
+				while (!_stack.empty()) {
+					const node* _ptr = _stack.back();
+					bool _ready = true;
+					for (const node_ptr& _child : _ptr->m_children) {
+						if (_child->m_stats_dirty) { _stack.emplace_back(_child.get()); _ready = false; }
+					}
+					if (!_ready) { continue; } // children first, this node is visited again once they are clean
+					_ptr->m_subtree_size = 1ULL;
+					_ptr->m_height = 0ULL;
+					for (const node_ptr& _child : _ptr->m_children) {
+						_ptr->m_subtree_size += _child->m_subtree_size;
+						_ptr->m_height = std::max<std::size_t>(_ptr->m_height, _child->m_height + 1ULL);
+					}
+					_ptr->m_stats_dirty = false;
+					_stack.pop_back();
+				}
+			}
 
 			bool _is_first_child(node_ptr_list::iterator _iter) {
 				node_ptr_list& _parent_list = _parent()->m_children;
@@ -111,8 +316,7 @@ namespace util
 			}
 
 			node_ptr_list::iterator _get_iter() {
-				node_ptr_list& _parent_list = _parent()->m_children;
-				return std::find(_parent_list.begin(), _parent_list.end(), this->shared_from_this());
+				return m_self;
 			}
 
 			node_ptr_list::iterator _next_sibling_iter() {
@@ -129,21 +333,61 @@ namespace util
 
 			node_ptr _emplace_back(const value_type& _val) {
 				node_ptr _new = m_children.emplace_back(std::make_shared<node>());
+				_new->m_self = std::prev(m_children.end());
 				_new->_set_parent(this->shared_from_this());
 				_new->_set_val(_val);
 				_new->_set_depth(m_depth + 1);
+				_new->m_top = m_top;
+				_on_children_changed(1);
+				_new->_index_attach(m_index);
+				return _new;
+			}
+
+			/*
+			 * @brief appends a copy of '_src' (without its children) allocated from '_arena', takes over its clean size and height.
+			 * the caller updates the ancestors of the copy target once all nodes are in place
+			 */
+			node_ptr _emplace_back_copy(const node& _src, const std::shared_ptr<node_arena>& _arena) {
+				node_ptr _new = m_children.emplace_back(std::allocate_shared<node>(node_arena_allocator<node>(_arena)));
+				_new->m_self = std::prev(m_children.end());
+				_new->m_parent = this->weak_from_this();
+				_new->m_parent_ptr = this;
+				_new->m_top = m_top;
+				_new->_set_val(_src.value());
+				_new->_set_depth(m_depth + 1);
+				_new->m_subtree_size = _src.m_subtree_size;
+				_new->m_height = _src.m_height;
+				_new->_index_attach(m_index);
 				return _new;
 			}
 
 			node_ptr _emplace_front(const value_type& _val) {
 				node_ptr _new = m_children.emplace_front(std::make_shared<node>());
+				_new->m_self = m_children.begin();
 				_new->_set_parent(this->shared_from_this());
 				_new->_set_val(_val);
 				_new->_set_depth(m_depth + 1);
+				_new->m_top = m_top;
+				_on_children_changed(1);
+				_new->_index_attach(m_index);
 				return _new;
 			}
 
 		public:
+			/*
+			 * @brief takes the subtree apart with an explicit stack instead of letting the child lists destroy each other recursively.
+			 * inner nodes are moved out of their parents before they die, so every destructor only finds leaves (or nothing) to
+			 * free in its list. subtrees that are still shared elsewhere are left intact
+			 */
+			~node() {
+				std::vector<node_ptr> _stack;
+				_release_inner_children(_stack);
+				while (!_stack.empty()) {
+					node_ptr _ptr = std::move(_stack.back());
+					_stack.pop_back();
+					_ptr->_release_inner_children(_stack);
+				}
+			}
 
 			////////////////////////////////////////
 			/// value and adjacent node access
@@ -158,6 +402,7 @@ namespace util
 			 * @returns reference to the value of the node
 			 */
 			value_type& value() { if (m_val) { return *m_val; } throw std::runtime_error("value of node was nullptr"); }
+			const value_type& value() const { if (m_val) { return *m_val; } throw std::runtime_error("value of node was nullptr"); }
 			/*
 			 * @returns distance from the node to the root of the tree
 			 */
@@ -170,6 +415,16 @@ namespace util
 			 * @returns if the node has any sub-nodes 
 			 */
 			bool has_children() const { return static_cast<bool>(m_children.size()); }
+			/*
+			 * @returns number of nodes in this node's subtree, including the node itself
+			 * @brief O(1), after modifications the first call recomputes the affected branches
+			 */
+			std::size_t subtree_size() const { _refresh(); return m_subtree_size; }
+			/*
+			 * @returns longest distance from this node to a leaf below it (0 for leaves)
+			 * @brief O(1), after modifications the first call recomputes the affected branches
+			 */
+			std::size_t height() const { _refresh(); return m_height; }
 			/*
 			 * @returns reference to next sibling-node, if there is one 
 			 * @throws std::runtime_error - if called on the last sibling
@@ -220,9 +475,13 @@ namespace util
 			 */
 			node& emplace_next_sibling(const value_type& _val) {
 				typename node_ptr_list::iterator _iter =  _parent()->m_children.insert(std::next(_get_iter()), std::make_shared<node>());
+				(*_iter)->m_self = _iter;
 				(*_iter)->_set_depth(m_depth);
 				(*_iter)->_set_val(_val);
 				(*_iter)->_set_parent(_parent());
+				(*_iter)->m_top = m_top;
+				_parent_raw()->_on_children_changed(1);
+				(*_iter)->_index_attach(m_index);
 				return **_iter;
 			}
 			/*
@@ -232,9 +491,13 @@ namespace util
 			 */
 			node& emplace_prev_sibling(const value_type& _val) {
 				typename node_ptr_list::iterator _iter = _parent()->m_children.insert(_get_iter(), std::make_shared<node>());
+				(*_iter)->m_self = _iter;
 				(*_iter)->_set_depth(m_depth);
 				(*_iter)->_set_val(_val);
 				(*_iter)->_set_parent(_parent());
+				(*_iter)->m_top = m_top;
+				_parent_raw()->_on_children_changed(1);
+				(*_iter)->_index_attach(m_index);
 				return **_iter;
 			}
 			/*
@@ -252,39 +515,40 @@ namespace util
 		class iterator
 		{
 			friend tree;
+			friend const_iterator;
+			friend reverse_iterator;
 
 			node_wptr m_ptr;
 			node_wptr m_root_ptr;
 
 			node_ptr _get_next(node_ptr _ptr) {
-				if (_ptr == node_ptr(m_root_ptr)) { return _ptr; }
-				typename node_ptr_list::iterator _iter = _ptr->_get_iter();
-				if (_ptr->_is_last_child(_iter)) {
-					return _get_next(_ptr->_parent());
-				}
-				else {
-					return *std::next(_iter);
+				node_ptr _root = node_ptr(m_root_ptr);
+				while (_ptr != _root) {
+					typename node_ptr_list::iterator _iter = _ptr->_get_iter();
+					if (!_ptr->_is_last_child(_iter)) { return *std::next(_iter); }
+					_ptr = _ptr->_parent();
 				}
+				return _ptr;
 			}
 
-			/*node_ptr _get_prev(node_ptr _ptr) {
-				if (_ptr == node_ptr(m_root_ptr)) { return _ptr; }
-				typename node_ptr_list::iterator _iter = _ptr->_get_iter();
-				if (_ptr->_is_first_child(_iter)) {
-					return _get_prev(_ptr->_parent());
-				}
-				else {
-					return *std::prev(_iter);
+			// the root (end) precedes the first node and follows the last one
+			node_ptr _get_prev(node_ptr _ptr) {
+				if (_ptr != node_ptr(m_root_ptr)) {
+					typename node_ptr_list::iterator _iter = _ptr->_get_iter();
+					if (_ptr->_is_first_child(_iter)) { return _ptr->_parent(); }
+					_ptr = *std::prev(_iter);
 				}
-			}*/
+				while (_ptr->has_children()) { _ptr = _ptr->m_children.back(); }
+				return _ptr;
+			}
 
 			bool _is_root() const { return node_ptr(m_ptr) == node_ptr(m_root_ptr); }
 
 			iterator(node_ptr _root, node_ptr _node) : m_root_ptr(_root), m_ptr(_node) {}
 
 		public:
-			node_ptr operator->() { if (_is_root()) { throw std::runtime_error("cannot dereference end iterator"); } return node_ptr(m_ptr); }
-			node& operator*() { if (_is_root()) { throw std::runtime_error("cannot dereference end iterator"); } return *node_ptr(m_ptr); }
+			node_ptr operator->() const { if (_is_root()) { throw std::runtime_error("cannot dereference end iterator"); } return node_ptr(m_ptr); }
+			node& operator*() const { if (_is_root()) { throw std::runtime_error("cannot dereference end iterator"); } return *node_ptr(m_ptr); }
 
 			iterator& operator++() {
 				if (_is_root()) { throw std::runtime_error("cannot increment end iterator"); }
@@ -304,15 +568,10 @@ namespace util
 				return _iter;
 			}
 
-			/*iterator& operator--() {
-				if (_is_root()) { throw std::runtime_error("cannot decrement begin iterator"); }
-				node& _ref = *node_ptr(m_ptr);
-				if (_ref.has_children()) {
-					m_ptr = _ref.m_children.back();
-				}
-				else {
-					m_ptr = _get_prev(node_ptr(m_ptr));
-				}
+			iterator& operator--() {
+				node_ptr _prev = _get_prev(node_ptr(m_ptr));
+				if (_prev == node_ptr(m_root_ptr)) { throw std::runtime_error("cannot decrement begin iterator"); }
+				m_ptr = _prev;
 				return *this;
 			}
 
@@ -320,13 +579,13 @@ namespace util
 				iterator _iter(*this);
 				this->operator--();
 				return _iter;
-			}*/
+			}
 
-			friend static bool operator==(const iterator& i, const iterator& j) { 
+			friend bool operator==(const iterator& i, const iterator& j) { 
 				if (node_ptr(i.m_root_ptr) != node_ptr(j.m_root_ptr)) { throw std::runtime_error("cannot compare iterators of different trees"); }
 				return node_ptr(i.m_ptr) == node_ptr(j.m_ptr); 
 			}
-			friend static bool operator!=(const iterator& i, const iterator& j) { 
+			friend bool operator!=(const iterator& i, const iterator& j) { 
 				if (node_ptr(i.m_root_ptr) != node_ptr(j.m_root_ptr)) { throw std::runtime_error("cannot compare iterators of different trees"); }
 				return node_ptr(i.m_ptr) != node_ptr(j.m_ptr); 
 			}
@@ -344,31 +603,251 @@ namespace util
 			return iterator(m_root, m_root);
 		}
 
-		//class const_iterator
-		//{
+		/*
+		 * @returns iterator to first node of the tree, or to the end if there are none
+		 */
+		const_iterator begin() const {
+			return const_iterator(iterator(m_root, m_root->has_children() ? m_root->m_children.front() : m_root));
+		}
+		/*
+		 * @returns iterator to end/header node of the tree
+		 */
+		const_iterator end() const {
+			return const_iterator(iterator(m_root, m_root));
+		}
+
+		/*
+		 * same traversal as iterator, but only grants const access to the nodes
+		 */
+		class const_iterator
+		{
+			friend tree;
+
+			iterator m_iter;
+
+		public:
+			const_iterator(const iterator& _iter) : m_iter(_iter) {}
+
+			std::shared_ptr<const node> operator->() const { return m_iter.operator->(); }
+			const node& operator*() const { return *m_iter; }
+
+			const_iterator& operator++() { ++m_iter; return *this; }
+			const_iterator operator++(int) { const_iterator _iter(*this); ++m_iter; return _iter; }
+			const_iterator& operator--() { --m_iter; return *this; }
+			const_iterator operator--(int) { const_iterator _iter(*this); --m_iter; return _iter; }
+
+			friend bool operator==(const const_iterator& i, const const_iterator& j) { return i.m_iter == j.m_iter; }
+			friend bool operator!=(const const_iterator& i, const const_iterator& j) { return i.m_iter != j.m_iter; }
+		};
+		/*
+		 * @returns const iterator to first node of the tree, or to the end if there are none
+		 */
+		const_iterator cbegin() const {
+			return begin();
+		}
+		/*
+		 * @returns const iterator to end/header node of the tree
+		 */
+		const_iterator cend() const {
+			return end();
+		}
+
+		/*
+		 * walks the depth-first order of iterator backwards, starting at the last node
+		 */
+		class reverse_iterator
+		{
+			friend tree;
+
+			iterator m_iter; // points at the current node itself, the root marks the end
+
+			reverse_iterator(iterator _iter) : m_iter(_iter) {}
+
+		public:
+			node_ptr operator->() const { return m_iter.operator->(); }
+			node& operator*() const { return *m_iter; }
+
+			reverse_iterator& operator++() {
+				if (m_iter._is_root()) { throw std::runtime_error("cannot increment end iterator"); }
+				m_iter.m_ptr = m_iter._get_prev(node_ptr(m_iter.m_ptr));
+				return *this;
+			}
+
+			reverse_iterator operator++(int) {
+				reverse_iterator _iter(*this);
+				this->operator++();
+				return _iter;
+			}
+
+			/*
+			 * @returns iterator to the same node
+			 */
+			iterator base() const { return m_iter; }
+
+			friend bool operator==(const reverse_iterator& i, const reverse_iterator& j) { return i.m_iter == j.m_iter; }
+			friend bool operator!=(const reverse_iterator& i, const reverse_iterator& j) { return i.m_iter != j.m_iter; }
+		};
+		/*
+		 * @returns reverse iterator to the last node of the tree, or to the end if there are none
+		 */
+		reverse_iterator rbegin() {
+			iterator _iter = end();
+			_iter.m_ptr = _iter._get_prev(m_root);
+			return reverse_iterator(_iter);
+		}
+		/*
+		 * @returns reverse iterator to end/header node of the tree
+		 */
+		reverse_iterator rend() {
+			return reverse_iterator(end());
+		}
+
+		/*
+		 * visits every node after all of its children, the root marks the end.
+		 * follows the sibling/parent links, so stepping needs no extra memory.
+		 * invalidated by erasing the current node
+		 */
+		class post_order_iterator
+		{
+			friend tree;
+
+			node* m_ptr = nullptr;
+			node* m_root = nullptr;
+
+			static node* _first_leaf(node* _ptr) {
+				while (_ptr->has_children()) {
+					_ptr = _ptr->m_children.front().get();
+					if (_ptr->m_children.size() > 1ULL) { UTIL_PREFETCH(std::next(_ptr->m_children.begin())->get()); }
+				}
+				return _ptr;
+			}
+
+			post_order_iterator(node* _root, node* _node) : m_ptr(_node), m_root(_root) {}
 
-		//};
+		public:
+			node* operator->() const { if (m_ptr == m_root) { throw std::runtime_error("cannot dereference end iterator"); } return m_ptr; }
+			node& operator*() const { return *operator->(); }
 
-		//const_iterator cbegin() {
+			post_order_iterator& operator++() {
+				if (m_ptr == m_root) { throw std::runtime_error("cannot increment end iterator"); }
+				node* _parent = m_ptr->_parent_raw();
+				typename node_ptr_list::iterator _next = std::next(m_ptr->m_self);
+				if (_next == _parent->m_children.end()) {
+					m_ptr = _parent;
+				}
+				else {
+					m_ptr = _first_leaf(_next->get());
+					if (++_next != _parent->m_children.end()) { UTIL_PREFETCH(_next->get()); }
+				}
+				return *this;
+			}
 
-		//}
+			post_order_iterator operator++(int) {
+				post_order_iterator _iter(*this);
+				this->operator++();
+				return _iter;
+			}
+
+			friend bool operator==(const post_order_iterator& i, const post_order_iterator& j) { return i.m_ptr == j.m_ptr; }
+			friend bool operator!=(const post_order_iterator& i, const post_order_iterator& j) { return i.m_ptr != j.m_ptr; }
+		};
+		/*
+		 * @returns post-order iterator to the first leaf of the tree, or to the end if there are none
+		 */
+		post_order_iterator post_order_begin() {
+			return post_order_iterator(m_root.get(), post_order_iterator::_first_leaf(m_root.get()));
+		}
+		/*
+		 * @returns post-order iterator to end/header node of the tree
+		 */
+		post_order_iterator post_order_end() {
+			return post_order_iterator(m_root.get(), m_root.get());
+		}
 
-		//const_iterator cend() {
+		/*
+		 * visits the nodes level by level, each level from front to back.
+		 * the upcoming nodes are kept in a queue that is copied along with the iterator,
+		 * prefer pre-increment. invalidated by any modification of the tree
+		 */
+		class breadth_first_iterator
+		{
+			friend tree;
 
-		//}
+			std::deque<node*> m_queue; // front is the current node, empty at the end
+			std::size_t m_min_depth = 1ULL;
+			std::size_t m_max_depth = static_cast<std::size_t>(-1);
 
-		//class reverse_iterator
-		//{
+			void _expand_front() {
+				node* _ptr = m_queue.front();
+				m_queue.pop_front();
+				if (_ptr->m_depth < m_max_depth) {
+					for (node_ptr& _child : _ptr->m_children) { m_queue.push_back(_child.get()); }
+				}
+			}
 
-		//};
+			// skips the levels above m_min_depth and prefetches the next two nodes
+			void _settle() {
+				while (!m_queue.empty() && m_queue.front()->m_depth < m_min_depth) { _expand_front(); }
+				if (m_queue.size() > 1ULL) { UTIL_PREFETCH(m_queue[1]); }
+				if (m_queue.size() > 2ULL) { UTIL_PREFETCH(m_queue[2]); }
+			}
 
-		//reverse_iterator rbegin() {
+			breadth_first_iterator() = default;
+			breadth_first_iterator(node* _root, std::size_t _min_depth, std::size_t _max_depth)
+				: m_min_depth(std::max(_min_depth, static_cast<std::size_t>(1ULL))), m_max_depth(_max_depth) {
+				m_queue.push_back(_root);
+				_settle();
+			}
 
-		//}
+		public:
+			node* operator->() const { if (m_queue.empty()) { throw std::runtime_error("cannot dereference end iterator"); } return m_queue.front(); }
+			node& operator*() const { return *operator->(); }
 
-		//reverse_iterator rend() {
+			breadth_first_iterator& operator++() {
+				if (m_queue.empty()) { throw std::runtime_error("cannot increment end iterator"); }
+				_expand_front();
+				_settle();
+				return *this;
+			}
 
-		//}
+			breadth_first_iterator operator++(int) {
+				breadth_first_iterator _iter(*this);
+				this->operator++();
+				return _iter;
+			}
+
+			friend bool operator==(const breadth_first_iterator& i, const breadth_first_iterator& j) {
+				if (i.m_queue.empty() || j.m_queue.empty()) { return i.m_queue.empty() == j.m_queue.empty(); }
+				return i.m_queue.front() == j.m_queue.front();
+			}
+			friend bool operator!=(const breadth_first_iterator& i, const breadth_first_iterator& j) { return !(i == j); }
+		};
+		/*
+		 * @returns breadth-first iterator to the first node of the tree, or to the end if there are none
+		 */
+		breadth_first_iterator breadth_first_begin() {
+			return breadth_first_iterator(m_root.get(), 1ULL, static_cast<std::size_t>(-1));
+		}
+		/*
+		 * @returns breadth-first iterator past the last level
+		 */
+		breadth_first_iterator breadth_first_end() {
+			return breadth_first_iterator();
+		}
+		/*
+		 * @param _depth - depth of the level, first-level nodes have depth 1
+		 * @returns breadth-first iterator to the first node of the level, or to level_end() if there are none
+		 */
+		breadth_first_iterator level_begin(std::size_t _depth) {
+			if (!_depth) { return level_end(); } // the root holds no value
+			return breadth_first_iterator(m_root.get(), _depth, _depth);
+		}
+		/*
+		 * @returns breadth-first iterator past the last node of a level
+		 */
+		breadth_first_iterator level_end() {
+			return breadth_first_iterator();
+		}
 
 		////////////////////////////////////////
 		/// modifiers
@@ -397,9 +876,11 @@ namespace util
 		/*
 		 * @brief searches the tree for a given value
 		 * @param _val - the value to look for
-		 * @returns reference to the first node found with that value
+		 * @returns reference to the first node in pre-order (depth-first) holding that value, also while the tree is indexed
 		 */
 		node& find_first(const value_type& _val) {
+			if (const std::unordered_set<node*>* _indexed = _index_lookup(_val)) { return *_first_in_pre_order(*_indexed); }
+			if (indexed()) { throw std::runtime_error("tree does not contain node with given value"); }
 			for (iterator _iter = begin(); _iter != end(); ++_iter) {
 				if (_iter->value() == _val) { return *_iter; }
 			}
@@ -408,9 +889,11 @@ namespace util
 		/*
 		 * @brief searches the tree for a given value
 		 * @param _val - the value to look for
-		 * @returns iterator to the first node found with that value
+		 * @returns iterator to the first node in pre-order (depth-first) holding that value, also while the tree is indexed
 		 */
 		iterator find_first_iterator(const value_type& _val) {
+			if (const std::unordered_set<node*>* _indexed = _index_lookup(_val)) { return iterator(m_root, _first_in_pre_order(*_indexed)->shared_from_this()); }
+			if (indexed()) { throw std::runtime_error("tree does not contain node with given value"); }
 			for (iterator _iter = begin(); _iter != end(); ++_iter) {
 				if (_iter->value() == _val) { return _iter; }
 			}
@@ -423,6 +906,10 @@ namespace util
 		 */
 		std::vector<node_ref> find(const value_type& _val) {
 			std::vector<node_ref> _res;
+			if (indexed()) {
+				if (const std::unordered_set<node*>* _indexed = _index_lookup(_val)) { for (node* _ptr : *_indexed) { _res.emplace_back(*_ptr); } }
+				return _res;
+			}
 			for (iterator _iter = begin(); _iter != end(); ++_iter) {
 				if (_iter->value() == _val) {
 					_res.emplace_back(*_iter);
@@ -437,6 +924,10 @@ namespace util
 		 */
 		std::vector<iterator> find_iterators(const value_type& _val) {
 			std::vector<iterator> _res;
+			if (indexed()) {
+				if (const std::unordered_set<node*>* _indexed = _index_lookup(_val)) { for (node* _ptr : *_indexed) { _res.emplace_back(iterator(m_root, _ptr->shared_from_this())); } }
+				return _res;
+			}
 			for (iterator _iter = begin(); _iter != end(); ++_iter) {
 				if (_iter->value() == _val) {
 					_res.emplace_back(_iter);
@@ -473,11 +964,127 @@ namespace util
 			return _res;
 		}
 
+		/*
+		 * @brief follows a path of values from the first level down, e.g. { "config", "network", "port" }.
+		 * every level takes the first child holding the segment, nodes with a child hash answer in O(1) (see enable_index())
+		 * @returns reference to the node at the end of the path
+		 * @throws std::runtime_error - if the path is empty or the tree does not contain it
+		 */
+		node& at_path(const std::vector<value_type>& _path) {
+			node* _ptr = m_root.get();
+			for (const value_type& _segment : _path) {
+				_ptr = _find_child(_ptr, _segment);
+				if (!_ptr) { throw std::runtime_error("tree does not contain path"); }
+			}
+			if (_ptr == m_root.get()) { throw std::runtime_error("path is empty"); }
+			return *_ptr;
+		}
+		/*
+		 * @brief at_path() for a path string like "config/network/port", empty segments are skipped
+		 * @param _separator - character between the segments
+		 */
+		node& at_path(std::string_view _path, char _separator = '/') requires std::constructible_from<value_type, std::string_view> {
+			node* _ptr = m_root.get();
+			while (!_path.empty()) {
+				std::size_t _pos = _path.find(_separator);
+				std::string_view _segment = _path.substr(0ULL, _pos);
+				_path = _pos == std::string_view::npos ? std::string_view() : _path.substr(_pos + 1ULL);
+				if (_segment.empty()) { continue; }
+				_ptr = _find_child(_ptr, value_type(_segment));
+				if (!_ptr) { throw std::runtime_error("tree does not contain path"); }
+			}
+			if (_ptr == m_root.get()) { throw std::runtime_error("path is empty"); }
+			return *_ptr;
+		}
+
+		////////////////////////////////////////
+		/// index
+		////////////////////////////////////////
+
+		/*
+		 * @brief builds an opt-in hash index from values to nodes. while it is enabled, find() and find_iterators() answer from it
+		 * in O(1) per result instead of scanning (the results are in no particular order). find_first() and find_first_iterator()
+		 * still return the first match in pre-order, resolved among the indexed matches without scanning the tree.
+		 * nodes with at least '_child_hash_threshold' children also get a child hash for at_path().
+		 * the index is kept up to date by the emplace functions, erase(), clear(), node::operator= and copies of the tree.
+		 * changing a value through node::value() bypasses it.
+		 */
+		void enable_index(std::size_t _child_hash_threshold = 16ULL) requires indexable {
+			if (m_index) { return; }
+			m_index = std::make_unique<_index_type>();
+			m_index->m_child_threshold = std::max<std::size_t>(_child_hash_threshold, 1ULL);
+			_walk_subtree(m_root.get(), [this](node* _ptr) {
+				_ptr->m_index = m_index.get();
+				if (_ptr != m_root.get()) { m_index->_add(_ptr); }
+				if (_ptr->m_children.size() >= m_index->m_child_threshold) { m_index->_build_children(_ptr); }
+			});
+		}
+		/*
+		 * @brief drops the index, lookups scan the tree again
+		 */
+		void disable_index() {
+			if (!m_index) { return; }
+			_walk_subtree(m_root.get(), [](node* _ptr) { _ptr->m_index = nullptr; });
+			m_index.reset();
+		}
+		/*
+		 * @returns if enable_index() is in effect
+		 */
+		bool indexed() const {
+			return static_cast<bool>(m_index);
+		}
+
+		////////////////////////////////////////
+		/// parallel node access
+		////////////////////////////////////////
+
+		/*
+		 * @brief parallel filter(): the tree is split into subtree-tasks which run on '_pool', results keep depth-first order
+		 * @param _cond - function of the signature '[](const value_type&) -> bool', has to be safe to call concurrently
+		 * @param _serial_threshold - trees with fewer nodes are searched serially
+		 * @param _pool - thread pool to run the tasks on
+		 * @returns references to all nodes satisfying this condition
+		 */
+		std::vector<node_ref> filter_parallel(const filter_condition& _cond, std::size_t _serial_threshold = 4096ULL, thread_pool& _pool = thread_pool::shared()) {
+			std::vector<node_ref> _res;
+			for (node* _ptr : _filter_nodes_parallel(_cond, _serial_threshold, _pool)) { _res.emplace_back(*_ptr); }
+			return _res;
+		}
+		/*
+		 * @brief parallel filter_iterators(), see filter_parallel()
+		 * @returns iterators to all nodes satisfying this condition
+		 */
+		std::vector<iterator> filter_iterators_parallel(const filter_condition& _cond, std::size_t _serial_threshold = 4096ULL, thread_pool& _pool = thread_pool::shared()) {
+			std::vector<iterator> _res;
+			for (node* _ptr : _filter_nodes_parallel(_cond, _serial_threshold, _pool)) { _res.emplace_back(iterator(m_root, _ptr->shared_from_this())); }
+			return _res;
+		}
+		/*
+		 * @brief parallel find(), see filter_parallel()
+		 * @returns references to all nodes holding that value
+		 */
+		std::vector<node_ref> find_parallel(const value_type& _val, std::size_t _serial_threshold = 4096ULL, thread_pool& _pool = thread_pool::shared()) {
+			return filter_parallel([&_val](const value_type& _other) { return _other == _val; }, _serial_threshold, _pool);
+		}
+		/*
+		 * @brief parallel find_iterators(), see filter_parallel()
+		 * @returns iterators to all nodes holding that value
+		 */
+		std::vector<iterator> find_iterators_parallel(const value_type& _val, std::size_t _serial_threshold = 4096ULL, thread_pool& _pool = thread_pool::shared()) {
+			return filter_iterators_parallel([&_val](const value_type& _other) { return _other == _val; }, _serial_threshold, _pool);
+		}
+
 		/*
 		 * @brief erases every branch of the tree
 		 */
 		void clear() {
 			m_root->m_children.clear();
+			if constexpr (indexable) {
+				if (m_index) { m_index->m_nodes.clear(); m_index->m_children.clear(); }
+			}
+			m_root->m_subtree_size = 1ULL;
+			m_root->m_height = 0ULL;
+			m_root->m_stats_dirty = false;
 		}
 		/*
 		 * @brief erases node at given iterator
@@ -487,8 +1094,18 @@ namespace util
 		 */
 		iterator erase(iterator _where) {
 			if (_where == end()) { throw std::runtime_error("cannot erase end-iterator"); }
-			iterator _next = _where;  ++_next;
-			_where->_parent()->m_children.erase(_where->_get_iter());
+			iterator _next = _where;
+			_next.m_ptr = _next._get_next(node_ptr(_where.m_ptr)); // skips the subtree that is erased below
+			node_ptr _parent = _where->_parent();
+			std::size_t _removed = _where->subtree_size(); // the subtree is taken apart below anyway
+			if constexpr (indexable) {
+				if (m_index) {
+					m_index->_remove_child(_parent.get(), &*_where);
+					_walk_subtree(&*_where, [this](node* _ptr) { m_index->_remove(_ptr); m_index->m_children.erase(_ptr); });
+				}
+			}
+			_parent->m_children.erase(_where->_get_iter());
+			_parent->_on_children_changed(-static_cast<std::ptrdiff_t>(_removed));
 			return _next;
 		}
 
@@ -497,13 +1114,16 @@ namespace util
 		////////////////////////////////////////
 
 		/*
-		 * @brief traverses the entire tree to get node count
-		 * @returns total number of nodes
+		 * @returns total number of nodes, O(1)
 		 */
-		std::size_t size() {
-			std::size_t _res = 0ULL;
-			for (iterator _iter = begin(); _iter != end(); ++_iter) { ++_res; }
-			return _res;
+		std::size_t size() const {
+			return m_root->m_subtree_size - 1ULL;
+		}
+		/*
+		 * @returns depth of the deepest node in the tree (0 for an empty tree)
+		 */
+		std::size_t height() const {
+			return m_root->height();
 		}
 
 		////////////////////////////////////////
@@ -515,6 +1135,7 @@ namespace util
 		 */
 		friend void swap(tree& a, tree& b) {
 			std::swap(a.m_root, b.m_root);
+			std::swap(a.m_index, b.m_index);
 		}
 		/*
 		 * @brief default constructor
@@ -533,28 +1154,169 @@ namespace util
 		 */
 		tree(const tree& other) : tree() {
 			_copy_nodes(other.m_root, m_root);
+			if constexpr (indexable) {
+				if (other.m_index) { enable_index(other.m_index->m_child_threshold); }
+			}
 		}
-		tree& operator=(tree& other) {
-			swap(*this, other);
+		tree& operator=(const tree& other) {
+			if (this != &other) {
+				tree _copy(other);
+				swap(*this, _copy);
+			}
 			return *this;
 		}
 
 	private:
 
 		/*
-		 * @brief recursive node copying utility
+		 * @brief one unit of work for the parallel search: either a whole subtree or only its top node
+		 */
+		struct _search_task {
+			node* m_node;
+			bool m_subtree;
+		};
+
+		std::vector<node*> _filter_nodes_parallel(const filter_condition& _cond, std::size_t _serial_threshold, thread_pool& _pool) {
+			std::vector<node*> _res;
+			std::size_t _total = size();
+			m_root->_refresh(); // the task split below reads the subtree sizes
+			if (_total < _serial_threshold) {
+				for (node_ptr& _child : m_root->m_children) { _filter_subtree(_child.get(), _cond, _res); }
+				return _res;
+			}
+			// subtrees up to '_grain' nodes become one task, the top nodes of bigger subtrees are tasks of their own.
+			// tasks are generated in pre-order, so concatenating their results keeps depth-first order.
+			std::size_t _grain = std::max<std::size_t>(_serial_threshold / 4ULL, _total / (_pool.size() * 8ULL) + 1ULL);
+			std::vector<_search_task> _tasks;
+			std::vector<node*> _stack;
+			for (typename node_ptr_list::reverse_iterator _iter = m_root->m_children.rbegin(); _iter != m_root->m_children.rend(); ++_iter) { _stack.emplace_back(_iter->get()); }
+			while (!_stack.empty()) {
+				node* _node = _stack.back();
+				_stack.pop_back();
+				if (_node->m_subtree_size <= _grain) { _tasks.emplace_back(_search_task{ _node, true }); continue; }
+				_tasks.emplace_back(_search_task{ _node, false });
+				for (typename node_ptr_list::reverse_iterator _iter = _node->m_children.rbegin(); _iter != _node->m_children.rend(); ++_iter) { _stack.emplace_back(_iter->get()); }
+			}
+			std::vector<std::vector<node*>> _partial(_tasks.size());
+			_pool.parallel_for(_tasks.size(), [&](std::size_t _i) {
+				if (_tasks[_i].m_subtree) { _filter_subtree(_tasks[_i].m_node, _cond, _partial[_i]); }
+				else if (_cond(_tasks[_i].m_node->value())) { _partial[_i].emplace_back(_tasks[_i].m_node); }
+			});
+			for (std::vector<node*>& _part : _partial) { _res.insert(_res.end(), _part.begin(), _part.end()); }
+			return _res;
+		}
+
+		/*
+		 * @brief non-recursive pre-order search of the subtree of '_top' (including '_top')
+		 */
+		static void _filter_subtree(node* _top, const filter_condition& _cond, std::vector<node*>& _out) {
+			node* _iter = _top;
+			while (true) {
+				if (_cond(_iter->value())) { _out.emplace_back(_iter); }
+				if (!_iter->m_children.empty()) { _iter = _iter->m_children.front().get(); continue; }
+				while (_iter != _top) {
+					node* _parent = _iter->_parent_raw();
+					typename node_ptr_list::iterator _next = std::next(_iter->m_self);
+					if (_next != _parent->m_children.end()) { _iter = _next->get(); break; }
+					_iter = _parent;
+				}
+				if (_iter == _top) { break; }
+			}
+		}
+
+		/*
+		 * @brief nodes of the index holding '_val', nullptr if the tree is not indexed or has no such node
+		 */
+		const std::unordered_set<node*>* _index_lookup(const value_type& _val) const {
+			if constexpr (indexable) {
+				if (m_index) {
+					typename std::unordered_map<value_type, std::unordered_set<node*>>::const_iterator _iter = m_index->m_nodes.find(_val);
+					if (_iter != m_index->m_nodes.end()) { return &_iter->second; }
+				}
+			}
+			return nullptr;
+		}
+		/*
+		 * @returns the node of '_nodes' that comes first in pre-order.
+		 * marks the ancestors of every candidate, then descends from the root into the first child that is a candidate
+		 * or leads to one: O(candidates * depth + children passed on the way down)
+		 */
+		node* _first_in_pre_order(const std::unordered_set<node*>& _nodes) const {
+			if (_nodes.size() == 1ULL) { return *_nodes.begin(); }
+			std::unordered_set<const node*> _ancestors;
+			for (node* _ptr : _nodes) {
+				for (const node* _p = _ptr->_parent_raw(); _p && _ancestors.insert(_p).second; _p = _p->_parent_raw()) {}
+			}
+			const node* _iter = m_root.get();
+			while (_iter) {
+				const node* _next = nullptr;
+				for (const node_ptr& _child : _iter->m_children) {
+					if (_nodes.count(_child.get())) { return _child.get(); }
+					if (_ancestors.count(_child.get())) { _next = _child.get(); break; }
+				}
+				_iter = _next;
+			}
+			throw std::runtime_error("tree index is out of sync");
+		}
+
+		/*
+		 * @returns first child of '_parent' holding '_val', nullptr if there is none
+		 */
+		node* _find_child(node* _parent, const value_type& _val) const {
+			if constexpr (indexable) {
+				if (m_index) {
+					typename std::unordered_map<const node*, std::unordered_multimap<value_type, node*>>::const_iterator _map = m_index->m_children.find(_parent);
+					if (_map != m_index->m_children.end()) {
+						std::size_t _count = _map->second.count(_val);
+						if (_count == 0ULL) { return nullptr; }
+						if (_count == 1ULL) { return _map->second.find(_val)->second; }
+						// several siblings hold the value, fall through to keep the first one in child order
+					}
+				}
+			}
+			for (const node_ptr& _child : _parent->m_children) {
+				if (_child->value() == _val) { return _child.get(); }
+			}
+			return nullptr;
+		}
+
+		/*
+		 * @brief calls '_func' for '_top' and every node below it in pre-order, iterative with an explicit stack
+		 */
+		template <typename _Func>
+		static void _walk_subtree(node* _top, _Func&& _func) {
+			std::vector<node*> _stack{ _top };
+			while (!_stack.empty()) {
+				node* _ptr = _stack.back();
+				_stack.pop_back();
+				_func(_ptr);
+				for (typename node_ptr_list::reverse_iterator _iter = _ptr->m_children.rbegin(); _iter != _ptr->m_children.rend(); ++_iter) { _stack.emplace_back(_iter->get()); }
+			}
+		}
+
+		/*
+		 * @brief appends copies of every descendant of '_src' to '_target', iterative with an explicit stack.
+		 * all copies come from one node_arena that is sized by the cached subtree size of '_src'
 		 */
 		static void _copy_nodes(node_ptr _src, node_ptr _target) {
-			for (node_ptr& _ptr : _src->m_children) {
-				node_ptr _new = _target->_emplace_back(_ptr->value());
-				_new->_set_depth(_target->m_depth + 1);
-				if (_ptr->has_children()) {
-					_copy_nodes(_ptr, _new);
+			if (!_src->has_children()) { return; }
+			_src->_refresh();
+			std::size_t _count = _src->m_subtree_size - 1ULL;
+			std::shared_ptr<node_arena> _arena = std::make_shared<node_arena>(_count);
+			std::vector<std::pair<node*, node*>> _stack{ { _src.get(), _target.get() } }; // (source, copy) whose children are still missing
+			while (!_stack.empty()) {
+				std::pair<node*, node*> _pair = _stack.back();
+				_stack.pop_back();
+				for (node_ptr& _child : _pair.first->m_children) {
+					node_ptr _new = _pair.second->_emplace_back_copy(*_child, _arena);
+					if (_child->has_children()) { _stack.emplace_back(_child.get(), _new.get()); }
 				}
 			}
+			_target->_on_children_changed(static_cast<std::ptrdiff_t>(_count));
 		}
 
 		node_ptr m_root;
+		std::unique_ptr<_index_type> m_index;
 	};
 
 	////////////////////////////////////////
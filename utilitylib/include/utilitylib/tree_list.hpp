@@ -5,16 +5,14 @@
 #include <memory>
 #include <stdexcept>
 #include <concepts>
+#include <vector>
+#include <functional>
+#include "thread_pool.hpp"
 //////////////////////////////////////////////////
 /*
-* WORK IN PROGRESS
  * to do:
- * - minimize _valid checks / derefs -> maybe unchecked/checked functions
  * - const iterator, different algo-iterators
- * - benchmark in release for proper tests
- * - filter
  * - documentation
- * - copying
  */
 //////////////////////////////////////////////////
 namespace util
@@ -60,6 +58,11 @@ namespace util
 	 * | child_1 |    | child_2 |    | child_3  | // see no weak_ref from parent_1 to child_2, as it is not first or last child
 	 * +---------+ => +---------+ => +----------+ // also no weak_ref from child_1 to child_3
 	 * 
+	 * a node is always owned by its parent or previous sibling, so while a node is alive
+	 * its parent, previous sibling and children are as well. iteration, copying and lookup
+	 * therefore walk raw pointers (the _unchecked functions) instead of promoting weak_ptrs,
+	 * and teardown uses an explicit stack so long sibling chains cannot overflow the call stack.
+	 * like std::list, iterators to erased nodes are invalidated.
 	 */
 	//////////////////////////////////////////////////
 	
@@ -91,10 +94,10 @@ namespace util
 		/// was illegally accessed (when deleted)
 		////////////////////////////////////////
 
-		class bad_tree_node : public std::exception
+		class bad_tree_node : public std::runtime_error
 		{
 		public:
-			bad_tree_node(const char* const _Message) : std::exception(_Message) {}
+			bad_tree_node(const char* const _Message) : std::runtime_error(_Message) {}
 		};
 
 		////////////////////////////////////////
@@ -128,6 +131,11 @@ namespace util
 			node_ptr m_first_child;
 			node_wptr m_last_child;
 
+			// raw copies of the weak references for the _unchecked functions, always set together via the _link functions
+			tree_node* m_parent_raw = nullptr;
+			tree_node* m_prev_sibling_raw = nullptr;
+			tree_node* m_last_child_raw = nullptr;
+
 			value_type m_value;
 			std::size_t m_child_num = 0ULL;
 			std::size_t m_depth = 0ULL;
@@ -141,11 +149,19 @@ namespace util
 			bool _has_next_sibling() { return _valid(m_next_sibling); }
 			bool _has_prev_sibling() { return _valid(m_prev_sibling); }
 
-			node_ptr _parent_unchecked() const { return m_parent.lock(); }
-			node_ptr _next_sibling_unchecked() const { return m_next_sibling; }
-			node_ptr _prev_sibling_unchecked() const { return m_prev_sibling.lock(); }
-			node_ptr _first_child_unchecked() const { return m_first_child; }
-			node_ptr _last_child_unchecked() const { return m_last_child.lock(); }
+			/*
+			 * no checks and no weak_ptr promotion, nullptr if there is no such node.
+			 * safe as long as this node is alive, see the ownership notes above
+			 */
+			tree_node* _parent_unchecked() const { return m_parent_raw; }
+			tree_node* _next_sibling_unchecked() const { return m_next_sibling.get(); }
+			tree_node* _prev_sibling_unchecked() const { return m_prev_sibling_raw; }
+			tree_node* _first_child_unchecked() const { return m_first_child.get(); }
+			tree_node* _last_child_unchecked() const { return m_last_child_raw; }
+
+			void _link_parent(tree_node* _node) { m_parent = _node ? _node->weak_from_this() : node_wptr(); m_parent_raw = _node; }
+			void _link_prev_sibling(tree_node* _node) { m_prev_sibling = _node ? _node->weak_from_this() : node_wptr(); m_prev_sibling_raw = _node; }
+			void _link_last_child(tree_node* _node) { m_last_child = _node ? _node->weak_from_this() : node_wptr(); m_last_child_raw = _node; }
 
 		public:
 			/*
@@ -180,29 +196,52 @@ namespace util
 			m_header = tree_node::create(value_type());
 		}
 
-		tree_list(tree_list& _other)
+		/*
+		 * deep copy, iterative so the depth of '_other' is not limited by the call stack
+		 */
+		tree_list(const tree_list& _other) : tree_list()
 		{
-
+			_copy_nodes(_other);
 		}
 
-		tree_list(tree_list&& _other)
+		/*
+		 * '_other' is left as an empty tree
+		 */
+		tree_list(tree_list&& _other) noexcept : m_header(std::move(_other.m_header)), m_size(_other.m_size), m_depth(_other.m_depth)
 		{
-
+			_other.m_header = tree_node::create(value_type());
+			_other.m_size = 0ULL;
+			_other.m_depth = 0ULL;
 		}
 
-		tree_list& operator=(tree_list& _other)
+		tree_list& operator=(const tree_list& _other)
 		{
-
+			if (this != &_other)
+			{
+				tree_list _copy(_other);
+				swap(*this, _copy);
+			}
+			return *this;
 		}
 
-		tree_list& operator=(tree_list&& _other)
+		tree_list& operator=(tree_list&& _other) noexcept
 		{
-
+			if (this != &_other)
+			{
+				tree_list _moved(std::move(_other));
+				swap(*this, _moved);
+			}
+			return *this;
 		}
 
-		void swap(tree_list& a, tree_list& b)
+		/*
+		 * swaps the headers, so iterators stay valid and change the tree they belong to
+		 */
+		friend void swap(tree_list& a, tree_list& b) noexcept
 		{
-
+			std::swap(a.m_header, b.m_header);
+			std::swap(a.m_size, b.m_size);
+			std::swap(a.m_depth, b.m_depth);
 		}
 
 		~tree_list()
@@ -223,17 +262,37 @@ namespace util
 
 		tree_node& emplace_front(const value_type& _val)
 		{
-
+			return emplace_front_child(_deref_checked(m_header), _val);
 		}
 
 		tree_node& emplace_front_child(tree_node& _parent, const value_type& _val)
 		{
-
+			std::shared_ptr<tree_node> _ptr = tree_node::create(_val);
+			tree_node& _new = _deref_checked(_ptr);
+			_set_parent(_parent, _new);
+			_new.m_depth = _parent.m_depth + 1;
+			m_depth = _new.m_depth > m_depth ? _new.m_depth : m_depth;
+			if (_parent._has_children())
+			{
+				_connect_sibling(_new, *_parent.m_first_child);
+			}
+			else
+			{
+				_parent._link_last_child(&_new);
+			}
+			_parent.m_first_child = _ptr;
+			++m_size;
+			++_parent.m_child_num;
+			return _new;
 		}
 
-		tree_node& emplace_front_sibling(tree_node& _parent, const value_type& _val)
+		tree_node& emplace_front_sibling(tree_node& _sibling, const value_type& _val)
 		{
-
+			tree_node* _parent = _sibling._parent_unchecked();
+			if (!_parent) { throw std::runtime_error("cannot emplace sibling of header node"); }
+			tree_node* _prev = _sibling._prev_sibling_unchecked();
+			if (!_prev) { return emplace_front_child(*_parent, _val); }
+			return emplace_back_sibling(*_prev, _val);
 		}
 
 		tree_node& emplace_back(const value_type& _val)
@@ -251,13 +310,13 @@ namespace util
 			if (_parent._has_children())
 			{
 				tree_node& _last_child = _deref_checked(_parent.m_last_child);
-				_parent.m_last_child = _ptr;
+				_parent._link_last_child(&_new);
 				_connect_sibling(_last_child, _new);
 			}
 			else
 			{
 				_parent.m_first_child = _ptr;
-				_parent.m_last_child = _ptr;
+				_parent._link_last_child(&_new);
 			}
 			++m_size;
 			++_parent.m_child_num;
@@ -273,6 +332,7 @@ namespace util
 			{ 
 				tree_node& _parent = _deref_checked(_sibling.m_parent);
 				_set_parent(_parent, _new); ++_parent.m_child_num; 
+				if (!_sibling._has_next_sibling()) { _parent._link_last_child(&_new); }
 			}
 			if (_sibling._has_next_sibling())
 			{
@@ -288,39 +348,47 @@ namespace util
 
 		void clear()
 		{
-			for (iterator _iter = begin(); _iter != end();) { _iter = erase(_iter); }
+			tree_node& _header = _deref_checked(m_header);
+			_destroy_chain(std::move(_header.m_first_child));
+			_header._link_last_child(nullptr);
+			_header.m_child_num = 0ULL;
+			m_size = 0ULL;
+			m_depth = 0ULL;
 		}
 
+		/*
+		 * @brief erases the node and its whole subtree
+		 * @returns iterator to the next node in depth-first order that is not part of the erased subtree
+		 */
 		iterator erase(iterator _where)
 		{
 			if (_where == end()) { throw std::runtime_error("cannot erase end iterator"); }
-			if (_where.m_header != m_header) { throw std::runtime_error("cannot erase iterator to node of different tree"); }
+			if (_where.m_header != m_header.get()) { throw std::runtime_error("cannot erase iterator to node of different tree"); }
 
 			tree_node& _mynode = *_where;
-			node_ptr _next_valid_node = nullptr;
-
-			if (_mynode._has_next_sibling()) { _next_valid_node = _promote_checked(_mynode.m_next_sibling); }
-			else if (_mynode._has_parent()) { _next_valid_node = _promote_checked(_mynode.m_parent); }
-			else { _next_valid_node = m_header; }
+			tree_node& _parent = *_mynode._parent_unchecked();
+			tree_node* _prev = _mynode._prev_sibling_unchecked();
+			tree_node* _next_valid_node = _next_skip_subtree_unchecked(&_mynode, m_header.get());
 
 			/*
-			 * iteratively delete every child node here
+			 * determine where strong refs are (parent for first child, else m_prev_sibling)
+			 * and take the last one, so the subtree is destroyed below and not by the unlinking
 			 */
-			tree_node& _parent = _deref_checked(_mynode.m_parent);
-			/*
-			 * determine where strong refs are (parent for first child, else m_prev_sibling
-			 */
-			if (!_mynode._has_prev_sibling())
+			node_ptr _owned = _prev ? std::move(_prev->m_next_sibling) : std::move(_parent.m_first_child);
+			if (_mynode._has_next_sibling())
 			{
-				if (_mynode._has_next_sibling()) { _deref_checked(_mynode.m_next_sibling).m_prev_sibling.reset(); }
-				_parent.m_first_child = _mynode.m_next_sibling; // deletion here through getting rid of the last strong ref
+				_mynode.m_next_sibling->_link_prev_sibling(_prev);
+				if (_prev) { _prev->m_next_sibling = std::move(_mynode.m_next_sibling); }
+				else { _parent.m_first_child = std::move(_mynode.m_next_sibling); }
 			}
 			else
 			{
-				_connect_sibling(_deref_checked(_mynode.m_prev_sibling), _deref_checked(_mynode.m_next_sibling));
+				_parent._link_last_child(_prev);
 			}
+			--_parent.m_child_num;
+			m_size -= _destroy_chain(std::move(_owned));
 
-			return iterator(_deref_checked(_next_valid_node), _deref_checked(_where.m_header));
+			return iterator(*_next_valid_node, *m_header);
 		}
 
 		////////////////////////////////////////
@@ -330,23 +398,28 @@ namespace util
 		std::vector<node_ref> filter(const filter_condition& _cond)
 		{
 			std::vector<node_ref> _res;
-			for (iterator _iter = begin(); _iter != end(); ++_iter)
-			{
-				if (_cond(*_iter)) { _res.emplace_back(std::ref(*_iter)); }
-			}
+			for (tree_node* _ptr : _filter_nodes(_cond)) { _res.emplace_back(std::ref(*_ptr)); }
 			return _res;
 		}
 
 		std::vector<iterator> filter_iterators(const filter_condition& _cond)
 		{
 			std::vector<iterator> _res;
-			for (iterator _iter = begin(); _iter != end(); ++_iter)
-			{
-				if (_cond(*_iter)) { _res.emplace_back(_iter); }
-			}
+			tree_node& _header = _deref_checked(m_header);
+			for (tree_node* _ptr : _filter_nodes(_cond)) { _res.emplace_back(iterator(*_ptr, _header)); }
 			return _res;
 		}
 
+		std::vector<node_ref> find(const value_type& _val)
+		{
+			return filter([&_val](const tree_node& _node) { return _node.m_value == _val; });
+		}
+
+		std::vector<iterator> find_iterators(const value_type& _val)
+		{
+			return filter_iterators([&_val](const tree_node& _node) { return _node.m_value == _val; });
+		}
+
 		tree_node& find_first(const value_type& _val)
 		{
 			for (iterator _iter = begin(); _iter != end(); ++_iter)
@@ -374,12 +447,104 @@ namespace util
 			throw std::runtime_error("tree does not contain node which satisfies condition");
 		}
 
+		/*
+		 * parallel filter: the tree is split into subtree-tasks which run on '_pool', results keep depth-first order.
+		 * '_cond' has to be safe to call concurrently. trees with fewer than '_serial_threshold' nodes are searched serially.
+		 */
+		std::vector<node_ref> filter_parallel(const filter_condition& _cond, std::size_t _serial_threshold = 4096ULL, thread_pool& _pool = thread_pool::shared())
+		{
+			std::vector<node_ref> _res;
+			for (tree_node* _ptr : _filter_nodes_parallel(_cond, _serial_threshold, _pool)) { _res.emplace_back(std::ref(*_ptr)); }
+			return _res;
+		}
+
+		std::vector<iterator> filter_iterators_parallel(const filter_condition& _cond, std::size_t _serial_threshold = 4096ULL, thread_pool& _pool = thread_pool::shared())
+		{
+			std::vector<iterator> _res;
+			tree_node& _header = _deref_checked(m_header);
+			for (tree_node* _ptr : _filter_nodes_parallel(_cond, _serial_threshold, _pool)) { _res.emplace_back(iterator(*_ptr, _header)); }
+			return _res;
+		}
+
+	private:
+
+		////////////////////////////////////////
+		/// parallel lookup utility
+		////////////////////////////////////////
+
+		struct _search_task
+		{
+			tree_node* m_node;
+			bool m_subtree; // whole subtree or only the node itself
+		};
+
+		std::vector<tree_node*> _filter_nodes_parallel(const filter_condition& _cond, std::size_t _serial_threshold, thread_pool& _pool)
+		{
+			std::vector<tree_node*> _res;
+			tree_node& _header = _deref_checked(m_header);
+			std::vector<_search_task> _tasks;
+			for (tree_node* _child = _header.m_first_child.get(); _child; _child = _child->m_next_sibling.get()) { _tasks.emplace_back(_search_task{ _child, true }); }
+			if (m_size < _serial_threshold)
+			{
+				for (_search_task& _task : _tasks) { _filter_subtree(_task.m_node, _cond, _res); }
+				return _res;
+			}
+			/*
+			 * subtree sizes are not tracked, so subtree-tasks are split level by level into
+			 * their top node and one task per child until there are enough tasks to balance.
+			 * every split keeps pre-order, so concatenating the results keeps depth-first order.
+			 */
+			std::size_t _target = _pool.size() * 8ULL;
+			bool _expanded = true;
+			while (_tasks.size() < _target && _expanded)
+			{
+				_expanded = false;
+				std::vector<_search_task> _split;
+				for (_search_task& _task : _tasks)
+				{
+					if (!_task.m_subtree || !_task.m_node->_has_children()) { _split.emplace_back(_task); continue; }
+					_split.emplace_back(_search_task{ _task.m_node, false });
+					for (tree_node* _child = _task.m_node->m_first_child.get(); _child; _child = _child->m_next_sibling.get()) { _split.emplace_back(_search_task{ _child, true }); }
+					_expanded = true;
+				}
+				_tasks = std::move(_split);
+			}
+			std::vector<std::vector<tree_node*>> _partial(_tasks.size());
+			_pool.parallel_for(_tasks.size(), [&](std::size_t _i)
+			{
+				if (_tasks[_i].m_subtree) { _filter_subtree(_tasks[_i].m_node, _cond, _partial[_i]); }
+				else if (_cond(*_tasks[_i].m_node)) { _partial[_i].emplace_back(_tasks[_i].m_node); }
+			});
+			for (std::vector<tree_node*>& _part : _partial) { _res.insert(_res.end(), _part.begin(), _part.end()); }
+			return _res;
+		}
+
+		/*
+		 * non-recursive pre-order search of the subtree of '_top' (including '_top')
+		 */
+		static void _filter_subtree(tree_node* _top, const filter_condition& _cond, std::vector<tree_node*>& _out)
+		{
+			tree_node* _iter = _top;
+			while (true)
+			{
+				if (_cond(*_iter)) { _out.emplace_back(_iter); }
+				if (_iter->m_first_child) { _iter = _iter->m_first_child.get(); continue; }
+				while (_iter != _top && !_iter->m_next_sibling) { _iter = _iter->_parent_unchecked(); }
+				if (_iter == _top) { break; }
+				_iter = _iter->m_next_sibling.get();
+			}
+		}
+
 	public:
 
 		////////////////////////////////////////
 		/// iteration
 		////////////////////////////////////////
 
+		/*
+		 * depth-first iterator. holds raw pointers and steps with the unchecked navigation,
+		 * so it is invalidated when the node it points to is erased
+		 */
 		class iterator
 		{
 			friend tree_list;
@@ -389,10 +554,10 @@ namespace util
 			/// iterator members
 			////////////////////////////////////////
 
-			node_wptr m_ptr; // node that the iterator points to
-			node_wptr m_header; // node to identify the tree that the iterator belongs to
+			tree_node* m_ptr; // node that the iterator points to
+			tree_node* m_header; // node to identify the tree that the iterator belongs to
 
-			explicit iterator(tree_node& _node, tree_node& _header) : m_ptr(_node.weak_from_this()), m_header(_header.weak_from_this()) {}
+			explicit iterator(tree_node& _node, tree_node& _header) : m_ptr(&_node), m_header(&_header) {}
 
 		public:
 
@@ -400,26 +565,34 @@ namespace util
 			/// public interface
 			////////////////////////////////////////
 
-			bool operator==(const typename tree_list<_Ty>::iterator& i)
+			bool operator==(const typename tree_list<_Ty>::iterator& i) const
 			{
 				if (m_header != i.m_header) { throw std::runtime_error("cannot compare iterators of different trees"); }
 				return m_ptr == i.m_ptr;
 			}
 
-			bool operator!=(const typename tree_list<_Ty>::iterator& i)
+			bool operator!=(const typename tree_list<_Ty>::iterator& i) const
 			{
 				if (m_header != i.m_header) { throw std::runtime_error("cannot compare iterators of different trees"); }
 				return m_ptr != i.m_ptr;
 			}
 
-			tree_node& operator*() { return _deref_checked(m_ptr); }
-			tree_node* operator->() { return &_deref_checked(m_ptr); }
+			tree_node& operator*() const { return *m_ptr; }
+			tree_node* operator->() const { return m_ptr; }
 
 			iterator& operator++()
 			{
-				m_ptr = _find_next_depth_first(m_ptr, m_header);
+				if (m_ptr == m_header) { throw std::runtime_error("cannot increment end iterator"); }
+				m_ptr = _next_depth_first_unchecked(m_ptr, m_header);
 				return *this;
 			}
+
+			iterator operator++(int)
+			{
+				iterator _iter(*this);
+				this->operator++();
+				return _iter;
+			}
 		};
 
 		iterator begin() { tree_node& _header = _deref_checked(m_header); return iterator(_header._has_children() ? *_header.m_first_child : _header, _header); }
@@ -431,40 +604,89 @@ namespace util
 		/// pointer handling utility
 		////////////////////////////////////////
 
-		static bool _valid(node_ptr _ptr) { return _ptr != nullptr; }
-		static bool _valid(node_wptr _wptr) { return !_wptr.expired(); }
-		static tree_node& _deref_checked(node_ptr _ptr) { if (!_valid(_ptr)) { throw bad_tree_node("tree_node was nullptr"); } return *_ptr; }
-		static tree_node& _deref_checked(node_wptr _wptr) { if (!_valid(_wptr)) { throw bad_tree_node("tree_node was nullptr"); } return *_wptr.lock(); }
-		static node_ptr _promote_checked(node_wptr _wptr) { if (!_valid(_wptr)) { throw bad_tree_node("tree_node was nullptr"); } return _wptr.lock(); }
+		static bool _valid(const node_ptr& _ptr) { return _ptr != nullptr; }
+		static bool _valid(const node_wptr& _wptr) { return !_wptr.expired(); }
+		static tree_node& _deref_checked(const node_ptr& _ptr) { if (!_valid(_ptr)) { throw bad_tree_node("tree_node was nullptr"); } return *_ptr; }
+		static tree_node& _deref_checked(const node_wptr& _wptr) { node_ptr _ptr = _wptr.lock(); if (!_ptr) { throw bad_tree_node("tree_node was nullptr"); } return *_ptr; }
+		static node_ptr _promote_checked(const node_wptr& _wptr) { node_ptr _ptr = _wptr.lock(); if (!_ptr) { throw bad_tree_node("tree_node was nullptr"); } return _ptr; }
 
 		////////////////////////////////////////
 		/// linked list/tree utility
 		////////////////////////////////////////
 
-		static void _connect_sibling(tree_node& _first, tree_node& _second) { _first.m_next_sibling = _second.shared_from_this(); _second.m_prev_sibling = _first.weak_from_this(); }
+		static void _connect_sibling(tree_node& _first, tree_node& _second) { _first.m_next_sibling = _second.shared_from_this(); _second._link_prev_sibling(&_first); }
 		static void _insert_sibling(tree_node& _first, tree_node& _second, tree_node& _insert) { _connect_sibling(_insert, _second); _connect_sibling(_first, _insert); }
-		static void _set_parent(tree_node& _parent, tree_node& _child) { _child.m_parent = _parent.weak_from_this(); }
+		static void _set_parent(tree_node& _parent, tree_node& _child) { _child._link_parent(&_parent); }
 
-		static node_wptr _find_next_depth_first(node_wptr _node, node_wptr _header)
+		/*
+		 * next node after the subtree of '_node' in depth-first order, '_header' if there is none
+		 */
+		static tree_node* _next_skip_subtree_unchecked(tree_node* _node, tree_node* _header)
 		{
-			tree_node& _mynode = _deref_checked(_node);
-			if (_mynode._has_children())
-			{
-				return _mynode.m_first_child;
-			}
-			else if (_mynode._has_next_sibling())
-			{
-				return _mynode.m_next_sibling;
-			}
-			else
+			while (_node != _header && !_node->m_next_sibling) { _node = _node->_parent_unchecked(); }
+			return _node == _header ? _node : _node->_next_sibling_unchecked();
+		}
+
+		static tree_node* _next_depth_first_unchecked(tree_node* _node, tree_node* _header)
+		{
+			if (_node->m_first_child) { return _node->_first_child_unchecked(); }
+			return _next_skip_subtree_unchecked(_node, _header);
+		}
+
+		std::vector<tree_node*> _filter_nodes(const filter_condition& _cond)
+		{
+			std::vector<tree_node*> _res;
+			for (tree_node* _child = m_header->_first_child_unchecked(); _child; _child = _child->_next_sibling_unchecked()) { _filter_subtree(_child, _cond, _res); }
+			return _res;
+		}
+
+		/*
+		 * appends a copy of every node of '_other' in one depth-first pass.
+		 * '_dst' mirrors the position of '_src', so no recursion or node map is needed
+		 */
+		void _copy_nodes(const tree_list& _other)
+		{
+			tree_node* _src_header = _other.m_header.get();
+			tree_node* _src = _src_header;
+			tree_node* _dst = m_header.get();
+			while (true)
 			{
-				node_ptr _current = _promote_checked(_mynode.m_parent);
-				while (!_valid(_current->m_next_sibling) && _current != _header)
+				if (_src->m_first_child)
 				{
-					_current = _promote_checked(_current->m_parent);
+					_src = _src->_first_child_unchecked();
+					_dst = &emplace_back_child(*_dst, _src->m_value);
+					continue;
 				}
-				return _current == _header ? _current : _current->m_next_sibling;
+				while (_src != _src_header && !_src->m_next_sibling)
+				{
+					_src = _src->_parent_unchecked();
+					_dst = _dst->_parent_unchecked();
+				}
+				if (_src == _src_header) { break; }
+				_src = _src->_next_sibling_unchecked();
+				_dst = &emplace_back_child(*_dst->_parent_unchecked(), _src->m_value);
+			}
+		}
+
+		/*
+		 * destroys '_first', its following siblings and all of their descendants with an explicit stack,
+		 * letting the shared_ptrs cascade would recurse once per sibling and level
+		 * @returns number of destroyed nodes
+		 */
+		static std::size_t _destroy_chain(node_ptr _first)
+		{
+			std::size_t _count = 0ULL;
+			std::vector<node_ptr> _stack;
+			if (_first) { _stack.emplace_back(std::move(_first)); }
+			while (!_stack.empty())
+			{
+				node_ptr _ptr = std::move(_stack.back());
+				_stack.pop_back();
+				if (_ptr->m_next_sibling) { _stack.emplace_back(std::move(_ptr->m_next_sibling)); }
+				if (_ptr->m_first_child) { _stack.emplace_back(std::move(_ptr->m_first_child)); }
+				++_count;
 			}
+			return _count;
 		}
 	};
 
@@ -0,0 +1,430 @@
+////////////////////////////////////////
+/// general utility header-only-library
+/// for convenience methods/types in C++
+/// 2025 Julian Benzel
+////////////////////////////////////////
+/// binary snapshots of util::tree
+////////////////////////////////////////
+#ifndef UTIL_TREE_SNAPSHOT_HPP
+#define UTIL_TREE_SNAPSHOT_HPP
+////////////////////////////////////////
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <stdexcept>
+#include "tree.hpp"
+#include "io.hpp"
+////////////////////////////////////////
+namespace util
+{
+	////////////////////////////////////////
+	/*
+	 * snapshot file layout (native byte order, checked on load):
+	 *
+	 * +-----------------+
+	 * | snapshot_header |
+	 * +-----------------+
+	 * | node records    |  // one snapshot_node per node in pre-order
+	 * +-----------------+
+	 * | values          |  // trivially copyable: _Ty[node_count]
+	 * +-----------------+  // std::string: uint64_t offsets[node_count + 1] into the character blob
+	 * | character blob  |
+	 * +-----------------+
+	 *
+	 * every section starts 64-byte aligned. the subtree size of a node is its skip link:
+	 * node 'i' has its first child at 'i + 1' (if its subtree size is > 1) and its next
+	 * sibling at 'i + subtree_size', if the node found there has the same depth.
+	 */
+	////////////////////////////////////////
+
+	struct snapshot_header {
+		char m_magic[8];
+		std::uint32_t m_version;
+		std::uint32_t m_byte_order; // 0x01020304 as written by the producer
+		std::uint32_t m_kind; // 0 = trivially copyable values, 1 = std::string values
+		std::uint32_t m_value_size; // sizeof(_Ty) for trivially copyable values
+		std::uint64_t m_node_count;
+		std::uint64_t m_nodes_offset;
+		std::uint64_t m_values_offset;
+		std::uint64_t m_blob_offset;
+		std::uint64_t m_blob_size;
+	};
+
+	struct snapshot_node {
+		std::uint64_t m_subtree_size; // this node and all of its descendants
+		std::uint64_t m_depth; // first-level nodes have depth 1, like in util::tree
+	};
+
+	template <typename _Ty>
+	concept snapshot_value = std::is_trivially_copyable_v<_Ty> || std::is_same_v<_Ty, std::string>;
+
+	namespace _snapshot
+	{
+		static constexpr char magic[8] = { 'U', 'T', 'I', 'L', 'T', 'R', 'E', 'E' };
+		static constexpr std::uint32_t version = 1U;
+		static constexpr std::uint32_t byte_order = 0x01020304U;
+		static constexpr std::uint64_t alignment = 64ULL;
+
+		static inline std::uint64_t align(std::uint64_t _offset) { return (_offset + alignment - 1ULL) / alignment * alignment; }
+
+		template <typename _Ty>
+		static constexpr std::uint32_t kind() { return std::is_same_v<_Ty, std::string> ? 1U : 0U; }
+
+		static inline void write_padded(std::ofstream& _out, const void* _data, std::uint64_t _size, std::uint64_t& _offset) {
+			static const char zeros[alignment] = {};
+			std::uint64_t _start = align(_offset);
+			_out.write(zeros, static_cast<std::streamsize>(_start - _offset));
+			_out.write(static_cast<const char*>(_data), static_cast<std::streamsize>(_size));
+			_offset = _start + _size;
+		}
+	}
+
+	/*
+	 * @brief writes '_tree' as a flat pre-order snapshot that tree_view can open without parsing
+	 * @param _tree - tree with trivially copyable or std::string values
+	 * @param _path - file to (over)write
+	 * @throws std::runtime_error - if the file cannot be written
+	 */
+	template <snapshot_value _Ty>
+	void write_snapshot(const tree<_Ty>& _tree, const std::filesystem::path& _path) {
+		std::vector<snapshot_node> _nodes;
+		std::vector<_Ty> _values; // trivially copyable payload
+		std::vector<std::uint64_t> _offsets; // std::string payload
+		std::string _blob;
+		_nodes.reserve(_tree.size());
+		if constexpr (std::is_same_v<_Ty, std::string>) { _offsets.reserve(_tree.size() + 1ULL); }
+		else { _values.reserve(_tree.size()); }
+
+		for (typename tree<_Ty>::const_iterator _iter = _tree.begin(); _iter != _tree.end(); ++_iter) {
+			_nodes.emplace_back(snapshot_node{ _iter->subtree_size(), _iter->depth() });
+			if constexpr (std::is_same_v<_Ty, std::string>) {
+				_offsets.emplace_back(_blob.size());
+				_blob += _iter->value();
+			}
+			else {
+				_values.emplace_back(_iter->value());
+			}
+		}
+		if constexpr (std::is_same_v<_Ty, std::string>) { _offsets.emplace_back(_blob.size()); }
+
+		snapshot_header _header{};
+		std::memcpy(_header.m_magic, _snapshot::magic, sizeof(_header.m_magic));
+		_header.m_version = _snapshot::version;
+		_header.m_byte_order = _snapshot::byte_order;
+		_header.m_kind = _snapshot::kind<_Ty>();
+		_header.m_value_size = std::is_same_v<_Ty, std::string> ? 0U : static_cast<std::uint32_t>(sizeof(_Ty));
+		_header.m_node_count = _nodes.size();
+		_header.m_nodes_offset = _snapshot::align(sizeof(snapshot_header));
+		_header.m_values_offset = _snapshot::align(_header.m_nodes_offset + _nodes.size() * sizeof(snapshot_node));
+		std::uint64_t _values_size = std::is_same_v<_Ty, std::string> ? _offsets.size() * sizeof(std::uint64_t) : _values.size() * sizeof(_Ty);
+		_header.m_blob_offset = _snapshot::align(_header.m_values_offset + _values_size);
+		_header.m_blob_size = _blob.size();
+
+		std::ofstream _out(_path, std::ofstream::binary | std::ofstream::trunc);
+		if (!_out) { throw std::runtime_error("could not open '" + _path.string() + "' for writing"); }
+		std::uint64_t _offset = 0ULL;
+		_snapshot::write_padded(_out, &_header, sizeof(_header), _offset);
+		_snapshot::write_padded(_out, _nodes.data(), _nodes.size() * sizeof(snapshot_node), _offset);
+		if constexpr (std::is_same_v<_Ty, std::string>) { _snapshot::write_padded(_out, _offsets.data(), _values_size, _offset); }
+		else { _snapshot::write_padded(_out, _values.data(), _values_size, _offset); }
+		_snapshot::write_padded(_out, _blob.data(), _blob.size(), _offset);
+		if (!_out.flush()) { throw std::runtime_error("could not write '" + _path.string() + "'"); }
+	}
+
+	////////////////////////////////////////
+	/*
+	 * read-only tree over a snapshot written by write_snapshot()
+	 *
+	 * works directly on the snapshot bytes: opening validates the header and section bounds
+	 * in O(1) and allocates nothing per node. node records are checked against the range of
+	 * their parent as they are visited, validate() checks all of them at once. values of std::string snapshots are returned as
+	 * std::string_view into the snapshot. either views caller-owned memory (which has to stay
+	 * alive and 64-byte aligned) or maps and owns a file.
+	 */
+	////////////////////////////////////////
+	template <snapshot_value _Ty>
+	class tree_view
+	{
+	public:
+		class node;
+		class iterator;
+		class child_iterator;
+
+		using value_type = _Ty;
+		using value_ref = std::conditional_t<std::is_same_v<_Ty, std::string>, std::string_view, const _Ty&>;
+
+		////////////////////////////////////////
+		/// node handle
+		////////////////////////////////////////
+
+		class node
+		{
+			friend tree_view;
+			friend iterator;
+			friend child_iterator;
+
+			const tree_view* m_view = nullptr;
+			std::uint64_t m_index = 0ULL;
+
+			node(const tree_view* _view, std::uint64_t _index) : m_view(_view), m_index(_index) {}
+
+			const snapshot_node& _record() const {
+				const snapshot_node& _rec = m_view->m_nodes[m_index];
+				if (!_rec.m_depth || !_rec.m_subtree_size || _rec.m_subtree_size > m_view->m_header->m_node_count - m_index) {
+					throw std::runtime_error("snapshot node record is corrupt");
+				}
+				return _rec;
+			}
+
+		public:
+			node() = default;
+
+			/*
+			 * @returns the node's value, a std::string_view into the snapshot for string trees
+			 */
+			value_ref value() const { return m_view->_value(m_index); }
+			/*
+			 * @returns position of the node in pre-order
+			 */
+			std::uint64_t index() const { return m_index; }
+			/*
+			 * @returns distance from the node to the (implicit) root, first-level nodes have depth 1
+			 */
+			std::size_t depth() const { return static_cast<std::size_t>(_record().m_depth); }
+			/*
+			 * @returns number of nodes in this node's subtree, including the node itself
+			 */
+			std::size_t subtree_size() const { return static_cast<std::size_t>(_record().m_subtree_size); }
+			bool has_children() const { return _record().m_subtree_size > 1ULL; }
+			bool has_next_sibling() const {
+				std::uint64_t _next = m_index + _record().m_subtree_size;
+				return _next < m_view->size() && m_view->m_nodes[_next].m_depth == _record().m_depth;
+			}
+			/*
+			 * @throws std::runtime_error - if the node has no children
+			 */
+			node first_child() const {
+				if (!has_children()) { throw std::runtime_error("node has no children"); }
+				return node(m_view, m_index + 1ULL);
+			}
+			/*
+			 * @brief O(1) through the subtree-size skip link
+			 * @throws std::runtime_error - if called on the last sibling
+			 */
+			node next_sibling() const {
+				if (!has_next_sibling()) { throw std::runtime_error("no next sibling"); }
+				return node(m_view, m_index + _record().m_subtree_size);
+			}
+			/*
+			 * @returns range over the direct children of this node
+			 */
+			std::pair<child_iterator, child_iterator> children() const {
+				const snapshot_node& _rec = _record();
+				std::uint64_t _end = m_index + _rec.m_subtree_size;
+				return { child_iterator(m_view, m_index + 1ULL, _end, _rec.m_depth + 1ULL), child_iterator(m_view, _end, _end, _rec.m_depth + 1ULL) };
+			}
+
+			friend bool operator==(const node& i, const node& j) { return i.m_view == j.m_view && i.m_index == j.m_index; }
+			friend bool operator!=(const node& i, const node& j) { return !(i == j); }
+		};
+
+		////////////////////////////////////////
+		/// iterators
+		////////////////////////////////////////
+
+		/*
+		 * pre-order iterator, stepping is a plain index increment
+		 */
+		class iterator
+		{
+			friend tree_view;
+
+			node m_node;
+
+			iterator(const tree_view* _view, std::uint64_t _index) : m_node(_view, _index) {}
+
+		public:
+			const node& operator*() const { return m_node; }
+			const node* operator->() const { return &m_node; }
+
+			iterator& operator++() { ++m_node.m_index; return *this; }
+			iterator operator++(int) { iterator _iter(*this); ++m_node.m_index; return _iter; }
+
+			friend bool operator==(const iterator& i, const iterator& j) { return i.m_node == j.m_node; }
+			friend bool operator!=(const iterator& i, const iterator& j) { return i.m_node != j.m_node; }
+		};
+
+		/*
+		 * visits siblings only, skipping every subtree through its size.
+		 * every step checks that the sibling has the expected depth and ends within the parent's range '_end'
+		 */
+		class child_iterator
+		{
+			friend tree_view;
+
+			node m_node;
+			std::uint64_t m_end = 0ULL;
+			std::uint64_t m_depth = 0ULL;
+
+		public:
+			child_iterator(const tree_view* _view, std::uint64_t _index, std::uint64_t _end, std::uint64_t _depth) : m_node(_view, _index), m_end(_end), m_depth(_depth) {}
+
+			const node& operator*() const { return m_node; }
+			const node* operator->() const { return &m_node; }
+
+			child_iterator& operator++() {
+				const snapshot_node& _rec = m_node._record();
+				if (_rec.m_depth != m_depth || _rec.m_subtree_size > m_end - m_node.m_index) { throw std::runtime_error("snapshot node record is corrupt"); }
+				m_node.m_index += _rec.m_subtree_size;
+				return *this;
+			}
+			child_iterator operator++(int) { child_iterator _iter(*this); this->operator++(); return _iter; }
+
+			friend bool operator==(const child_iterator& i, const child_iterator& j) { return i.m_node == j.m_node; }
+			friend bool operator!=(const child_iterator& i, const child_iterator& j) { return i.m_node != j.m_node; }
+		};
+
+		////////////////////////////////////////
+		/// construction
+		////////////////////////////////////////
+
+		/*
+		 * @brief views a snapshot in caller-owned memory
+		 * @throws std::runtime_error - if the bytes are not a valid snapshot of _Ty values
+		 */
+		tree_view(const void* _data, std::size_t _size) {
+			_attach(static_cast<const std::uint8_t*>(_data), _size);
+		}
+		/*
+		 * @brief maps the snapshot file '_path' read-only, the view owns the mapping
+		 * @throws std::runtime_error - if the file cannot be mapped or is not a valid snapshot of _Ty values
+		 */
+		explicit tree_view(const std::filesystem::path& _path) : m_file(std::make_shared<mapped_file>(_path)) {
+			_attach(m_file->data(), m_file->size());
+		}
+
+		////////////////////////////////////////
+		/// access
+		////////////////////////////////////////
+
+		/*
+		 * @returns total number of nodes
+		 */
+		std::size_t size() const { return static_cast<std::size_t>(m_header->m_node_count); }
+		bool empty() const { return !m_header->m_node_count; }
+
+		iterator begin() const { return iterator(this, 0ULL); }
+		iterator end() const { return iterator(this, m_header->m_node_count); }
+		/*
+		 * @returns range over the first-level nodes
+		 */
+		std::pair<child_iterator, child_iterator> top_level() const {
+			return { child_iterator(this, 0ULL, m_header->m_node_count, 1ULL), child_iterator(this, m_header->m_node_count, m_header->m_node_count, 1ULL) };
+		}
+		/*
+		 * @returns node at pre-order position '_index'
+		 * @throws std::runtime_error - if out of range
+		 */
+		node at(std::uint64_t _index) const {
+			if (_index >= m_header->m_node_count) { throw std::runtime_error("index out of range"); }
+			return node(this, _index);
+		}
+
+		/*
+		 * @brief checks the depth and subtree size of every node record in one O(n) pass, for untrusted files
+		 * that are walked more than once. every subtree has to end within its parent and exactly where its last
+		 * descendant ends, every node has to start at depth 1 or one below the enclosing subtree
+		 * @throws std::runtime_error - if a record does not fit
+		 */
+		void validate() const {
+			std::vector<std::uint64_t> _ends; // end of every subtree enclosing the current node, innermost last
+			for (std::uint64_t _i = 0ULL; _i < m_header->m_node_count; ++_i) {
+				while (!_ends.empty() && _ends.back() == _i) { _ends.pop_back(); }
+				std::uint64_t _limit = _ends.empty() ? m_header->m_node_count : _ends.back();
+				const snapshot_node& _node = m_nodes[_i];
+				if (_node.m_depth != _ends.size() + 1ULL || !_node.m_subtree_size || _node.m_subtree_size > _limit - _i) {
+					throw std::runtime_error("snapshot node records are corrupt");
+				}
+				_ends.emplace_back(_i + _node.m_subtree_size);
+			}
+		}
+		/*
+		 * @brief rebuilds an owning util::tree from the snapshot
+		 * @throws std::runtime_error - if a node record is corrupt
+		 */
+		tree<_Ty> to_tree() const {
+			tree<_Ty> _res;
+			std::vector<typename tree<_Ty>::node*> _path; // _path[d - 1] is the last node seen at depth d
+			for (std::uint64_t _i = 0ULL; _i < m_header->m_node_count; ++_i) {
+				std::size_t _depth = static_cast<std::size_t>(m_nodes[_i].m_depth);
+				if (!_depth || _depth > _path.size() + 1ULL) { throw std::runtime_error("snapshot node record is corrupt"); }
+				_path.resize(_depth - 1ULL);
+				typename tree<_Ty>::node& _new = _path.empty() ? _res.emplace_back(_Ty(_value(_i))) : _path.back()->emplace_back(_Ty(_value(_i)));
+				_path.emplace_back(&_new);
+			}
+			return _res;
+		}
+
+	private:
+
+		std::shared_ptr<mapped_file> m_file; // only set if the view maps the file itself
+		const snapshot_header* m_header = nullptr;
+		const snapshot_node* m_nodes = nullptr;
+		const std::uint8_t* m_values = nullptr;
+		const char* m_blob = nullptr;
+
+		void _attach(const std::uint8_t* _data, std::size_t _size) {
+			if (_size < sizeof(snapshot_header)) { throw std::runtime_error("snapshot is too small"); }
+			if (reinterpret_cast<std::uintptr_t>(_data) % _snapshot::alignment) { throw std::runtime_error("snapshot memory is not 64-byte aligned"); }
+			const snapshot_header* _header = reinterpret_cast<const snapshot_header*>(_data);
+			if (std::memcmp(_header->m_magic, _snapshot::magic, sizeof(_snapshot::magic)) || _header->m_version != _snapshot::version) {
+				throw std::runtime_error("not a tree snapshot or unsupported version");
+			}
+			if (_header->m_byte_order != _snapshot::byte_order) { throw std::runtime_error("snapshot was written with a different byte order"); }
+			if (_header->m_kind != _snapshot::kind<_Ty>() || (_header->m_kind == 0U && _header->m_value_size != sizeof(_Ty))) {
+				throw std::runtime_error("snapshot holds a different value type");
+			}
+			// '_count' elements of '_width' bytes at '_offset' fit into the snapshot, written so that nothing can overflow
+			auto _fits = [_size](std::uint64_t _offset, std::uint64_t _count, std::uint64_t _width) {
+				return _offset <= _size && _count <= (_size - _offset) / _width;
+			};
+			std::uint64_t _count = _header->m_node_count; // bounded by the node section first, so '_count + 1' cannot wrap
+			bool _in_bounds = _fits(_header->m_nodes_offset, _count, sizeof(snapshot_node))
+				&& (_header->m_kind ? _fits(_header->m_values_offset, _count + 1ULL, sizeof(std::uint64_t)) : _fits(_header->m_values_offset, _count, sizeof(_Ty)))
+				&& _fits(_header->m_blob_offset, _header->m_blob_size, 1ULL);
+			if (!_in_bounds) { throw std::runtime_error("snapshot is truncated"); }
+			std::size_t _value_align = _header->m_kind ? alignof(std::uint64_t) : alignof(_Ty);
+			if (_header->m_nodes_offset % alignof(snapshot_node) || _header->m_values_offset % _value_align) {
+				throw std::runtime_error("snapshot sections are misaligned");
+			}
+			m_header = _header;
+			m_nodes = reinterpret_cast<const snapshot_node*>(_data + _header->m_nodes_offset);
+			m_values = _data + _header->m_values_offset;
+			m_blob = reinterpret_cast<const char*>(_data + _header->m_blob_offset);
+		}
+
+		value_ref _value(std::uint64_t _index) const {
+			if constexpr (std::is_same_v<_Ty, std::string>) {
+				const std::uint64_t* _offsets = reinterpret_cast<const std::uint64_t*>(m_values);
+				if (_offsets[_index] > _offsets[_index + 1ULL] || _offsets[_index + 1ULL] > m_header->m_blob_size) {
+					throw std::runtime_error("snapshot string offsets are corrupt");
+				}
+				return std::string_view(m_blob + _offsets[_index], static_cast<std::size_t>(_offsets[_index + 1ULL] - _offsets[_index]));
+			}
+			else {
+				return reinterpret_cast<const _Ty*>(m_values)[_index];
+			}
+		}
+	};
+
+	////////////////////////////////////////
+}
+////////////////////////////////////////
+#endif
+////////////////////////////////////////